@@ -8,6 +8,10 @@
 #include <pulcher-gfx/context.hpp>
 #include <pulcher-gfx/imgui.hpp>
 #include <pulcher-gfx/spritesheet.hpp>
+#include <pulcher-network/file-transfer.hpp>
+#include <pulcher-network/packet.hpp>
+#include <pulcher-network/shared.hpp>
+#include <pulcher-network/snapshot.hpp>
 #include <pulcher-physics/intersections.hpp>
 #include <pulcher-plugin/plugin.hpp>
 #include <pulcher-util/consts.hpp>
@@ -34,6 +38,15 @@ namespace {
 
 bool applyGitUpdate = true;
 
+// snapshots received from the server, the server encodes against whichever of
+// these was last acknowledged
+pul::network::SnapshotHistory serverSnapshots;
+uint32_t latestServerTick = pul::network::PacketSnapshot::NoBaseline;
+
+// assets the server offers are downloaded here, they are picked up by the
+// next launch
+pul::network::FileTransferClient fileTransfer;
+
 auto StartupOptions() -> argparse::ArgumentParser {
   auto options = argparse::ArgumentParser("pulcher-client", "0.0.1");
   options
@@ -61,6 +74,24 @@ auto StartupOptions() -> argparse::ArgumentParser {
     .implicit_value(true)
   ;
 
+  options
+    .add_argument("-s")
+    .help("server address to connect to (empty plays offline)")
+    .default_value(std::string{})
+  ;
+
+  options
+    .add_argument("-p")
+    .help(("server port"))
+    .default_value(std::to_string(pul::core::Config{}.networkPortAddress))
+  ;
+
+  options
+    .add_argument("-a")
+    .help("directory the server's assets are downloaded into")
+    .default_value(std::string{"assets"})
+  ;
+
   options
     .add_argument("-g")
     .help("do not automatically check for git updates")
@@ -83,6 +114,11 @@ auto CreateUserConfig(argparse::ArgumentParser const & userResults)
     windowResolution = userResults.get<std::string>("-w");
     framebufferResolution = userResults.get<std::string>("-r");
     config.mapPath = std::filesystem::path{userResults.get<std::string>("-m")};
+    config.networkIpAddress = userResults.get<std::string>("-s");
+    ::fileTransfer.root =
+      std::filesystem::path{userResults.get<std::string>("-a")};
+    config.networkPortAddress =
+      static_cast<uint16_t>(std::stoul(userResults.get<std::string>("-p")));
     if (userResults.get<bool>("-d")) {
       spdlog::set_level(spdlog::level::debug);
     }
@@ -197,10 +233,11 @@ static void ImGuiApplyStyling()
     colors[ImGuiCol_ModalWindowDimBg]      = ImVec4(0.80f, 0.81f, 0.81f, 0.35f);
 }
 
-// this gets capped at pul::util::MsPerFrame
+// this runs once per tick of the simulation clock
 void ProcessLogic(
   pul::plugin::Info const & plugin, pul::core::SceneBundle & scene
 ) {
+  ++ scene.clock.tick;
 
   // clear debug physics queries
   auto & queries = scene.PhysicsDebugQueries();
@@ -306,14 +343,23 @@ void ProcessRendering(
       "NOTE: RELOADING plugins will save animations, configs, etc"
     );
     ImGui::SameLine();
-    if (ImGui::Button("reset ms/frame")) {
-      scene.calculatedMsPerFrame = pul::util::MsPerFrame;
+    if (ImGui::Button("reset time scale")) {
+      scene.clock.timeScale = 1.0f;
     }
     ImGui::SliderFloat(
-      "ms / frame", &scene.calculatedMsPerFrame
-    , 1.0f, 1000.0f/0.9f
+      "time scale", &scene.clock.timeScale
+    , 0.1f, 50.0f
     , "%.3f", 4.0f
     );
+    pul::imgui::Text("tick rate {:.1f} Hz", scene.clock.TickRate());
+    for (
+      float const tickRate : { 1000.0f/pul::util::MsPerFrame, 120.0f, 128.0f }
+    ) {
+      ImGui::SameLine();
+      if (ImGui::Button(fmt::format("{:.1f} Hz", tickRate).c_str()))
+        { scene.clock.SetTickRate(tickRate); }
+    }
+    ImGui::Checkbox("adaptive substeps", &scene.clock.adaptiveSubsteps);
     ImGui::ColorEdit3("screen clear", &screenClearColor.x);
     pul::imgui::Text("CPU frames {}", numCpuFrames);
 
@@ -540,6 +586,86 @@ void ProcessRendering(
   pul::gfx::EndFrame();
 }
 
+void ReceiveSnapshot(
+  pul::plugin::Info const & plugin
+, pul::core::SceneBundle & scene
+, pul::network::ClientHost & client
+, pul::network::Event & event
+) {
+  auto reader = pul::network::PacketReader::Construct(event.packet);
+
+  pul::network::PacketSnapshot header;
+  if (!pul::network::ReadPacket(reader, header)) {
+    spdlog::error("malformed snapshot header");
+    return;
+  }
+
+  // snapshots are unreliable, anything older than what is applied is useless
+  if (
+      ::latestServerTick != pul::network::PacketSnapshot::NoBaseline
+   && header.tick <= ::latestServerTick
+  ) {
+    return;
+  }
+
+  pul::network::Snapshot const * baseline = nullptr;
+  if (header.baselineTick != pul::network::PacketSnapshot::NoBaseline) {
+    baseline = ::serverSnapshots.Find(header.baselineTick);
+
+    // the baseline fell out of the history, the server sends a full
+    // snapshot once the acknowledgements stop arriving
+    if (!baseline) { return; }
+  }
+
+  pul::network::Snapshot snapshot;
+  if (!pul::network::DecodeSnapshotDelta(baseline, reader, snapshot)) {
+    spdlog::error("malformed snapshot for tick {}", header.tick);
+    return;
+  }
+
+  auto & stored = ::serverSnapshots.Store(header.tick);
+  stored.entities = std::move(snapshot.entities);
+  ::latestServerTick = header.tick;
+
+  pul::network::PacketSnapshotAck ack;
+  ack.tick = header.tick;
+
+  auto writer =
+    pul::network::PacketWriter::Construct(
+      pul::network::PacketSnapshotAck::packetType
+    , pul::network::ChannelType::Unreliable
+    );
+  pul::network::WritePacket(writer, ack);
+  writer.Finish().Send(client);
+
+  plugin.ApplySnapshot(
+    scene, stored, header.playerNetworkId, header.inputTick
+  );
+}
+
+// the server runs the same input a tick after receiving it, the local player
+// predicts it in the meantime
+void SendInput(
+  pul::plugin::Info const & plugin
+, pul::core::SceneBundle const & scene
+, pul::network::ClientHost & client
+) {
+  pul::network::PacketPlayerInput input;
+  plugin.CapturePlayerInput(scene, input);
+
+  // remote players are shown as of the newest snapshot, the server rewinds
+  // its hitboxes to it for this input
+  input.viewTick = ::latestServerTick;
+
+  auto writer =
+    pul::network::PacketWriter::Construct(
+      pul::network::PacketPlayerInput::packetType
+    , pul::network::ChannelType::Unreliable
+    );
+  pul::network::WritePacket(writer, input);
+  writer.Finish().Send(client);
+}
+
 pul::plugin::Info InitializePlugins() {
   pul::plugin::Info plugins;
 
@@ -590,14 +716,58 @@ int main(int argc, char const ** argv) {
 
   plugin.Initialize(sceneBundle);
 
+  // -- connect to server, if there is one
+  auto network = pul::network::Network::Construct();
+  pul::network::ClientHost client;
+  if (network.valid && !sceneBundle.config.networkIpAddress.empty()) {
+    pul::network::ClientHost::ConstructInfo ci;
+    ci.address =
+      pul::network::Address::Construct(
+        sceneBundle.config.networkIpAddress.c_str()
+      , sceneBundle.config.networkPortAddress
+      );
+    ci.fnConnect = [](pul::network::Event &) {
+      spdlog::info("connected to server");
+    };
+    ci.fnDisconnect = [](pul::network::Event &) {
+      spdlog::info("disconnected from server");
+      ::serverSnapshots.Clear();
+      ::latestServerTick = pul::network::PacketSnapshot::NoBaseline;
+      ::fileTransfer.Disconnect();
+    };
+    ci.fnReceive =
+      [&plugin, &sceneBundle, &client](pul::network::Event & event) {
+        switch (event.type) {
+          default: break;
+          case pul::network::PacketType::Snapshot:
+            ::ReceiveSnapshot(plugin, sceneBundle, client, event);
+          break;
+          case pul::network::PacketType::FileManifest:
+            ::fileTransfer.ReceiveManifest(event);
+          break;
+          case pul::network::PacketType::FileChunk:
+            ::fileTransfer.ReceiveChunk(event);
+          break;
+        }
+      };
+
+    client = pul::network::ClientHost::Construct(ci);
+
+    if (!client.Valid()) {
+      spdlog::error(
+        "could not connect to {}:{}"
+      , sceneBundle.config.networkIpAddress
+      , sceneBundle.config.networkPortAddress
+      );
+    }
+  }
+
   auto renderBundle = pul::core::RenderBundle::Construct(plugin, sceneBundle);
 
   ImGuiApplyStyling();
 
   auto timePreviousFrameBegin = std::chrono::high_resolution_clock::now();
 
-  float msToCalculate = 0.0f;
-
   while (!glfwWindowShouldClose(pul::gfx::DisplayWindow())) {
     // -- get timing
     auto timeFrameBegin = std::chrono::high_resolution_clock::now();
@@ -611,25 +781,30 @@ int main(int argc, char const ** argv) {
       // -- update windowing events
       glfwPollEvents();
 
-      // -- logic, ~62 Hz
-      msToCalculate += deltaMs;
-      size_t calculatedFrames = 0ul;
-      while (msToCalculate >= sceneBundle.calculatedMsPerFrame) {
+      // -- network events, snapshots are applied before the logic runs
+      if (client.Valid()) { client.host.PollEvents(); }
+
+      // -- logic, at the tick rate of the simulation clock
+      size_t const calculatedFrames = sceneBundle.clock.Advance(deltaMs);
+      for (size_t frame = 0ul; frame < calculatedFrames; ++ frame) {
         // -- process logic
-        ++ calculatedFrames;
-        msToCalculate -= sceneBundle.calculatedMsPerFrame;
         ::ProcessLogic(plugin, sceneBundle);
 
+        if (client.Valid()) { ::SendInput(plugin, sceneBundle, client); }
+
         // -- update render bundle
         renderBundle.Update(plugin, sceneBundle);
       }
 
       sceneBundle.numCpuFrames = calculatedFrames;
 
+      if (client.Valid()) {
+        ::fileTransfer.Update(client);
+        client.host.Flush();
+      }
+
       // -- rendering interpolation
-      auto const msDeltaInterp =
-        msToCalculate / sceneBundle.calculatedMsPerFrame
-      ;
+      auto const msDeltaInterp = sceneBundle.clock.Interpolation();
       auto renderBundleInterp = renderBundle.Interpolate(plugin, msDeltaInterp);
 
       // -- rendering, unlimited Hz
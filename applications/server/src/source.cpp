@@ -0,0 +1,473 @@
+/* pulcher | aodq.net */
+
+#include <pulcher-core/config.hpp>
+#include <pulcher-core/scene-bundle.hpp>
+#include <pulcher-network/file-transfer.hpp>
+#include <pulcher-network/packet.hpp>
+#include <pulcher-network/shared.hpp>
+#include <pulcher-network/snapshot.hpp>
+#include <pulcher-physics/intersections.hpp>
+#include <pulcher-plugin/plugin.hpp>
+#include <pulcher-util/consts.hpp>
+#include <pulcher-util/log.hpp>
+
+#pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wshadow"
+  #include <argparse/argparse.hpp>
+#pragma GCC diagnostic pop
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <deque>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+volatile std::sig_atomic_t shutdownRequested = 0;
+
+// stop after this many ticks, 0 runs until interrupted
+size_t tickLimit = 0ul;
+
+size_t maxClients = 16ul;
+size_t clientSendBudget = 0ul;
+
+// inputs that arrive faster than they are simulated are dropped past this,
+// so a burst of packets can not build up latency
+constexpr size_t maxQueuedInputs = 8ul;
+
+struct Client {
+  ENetPeer * peer = nullptr;
+
+  // newest snapshot the client has confirmed, which deltas are encoded against
+  uint32_t ackedTick = pul::network::PacketSnapshot::NoBaseline;
+
+  uint32_t playerNetworkId = pul::network::PacketSnapshot::NoPlayer;
+
+  // inputs waiting to be simulated, one per tick, and the newest one that was
+  std::deque<pul::network::PacketPlayerInput> inputs;
+  uint32_t inputTick = pul::network::PacketSnapshot::NoBaseline;
+};
+
+std::vector<Client> clients;
+
+pul::network::SnapshotHistory snapshotHistory;
+
+// assets clients download on connecting, if a directory was given
+std::filesystem::path assetPath;
+pul::network::FileTransferServer fileTransfer;
+
+auto StartupOptions() -> argparse::ArgumentParser {
+  auto options = argparse::ArgumentParser("pulcher-server", "0.0.1");
+
+  options
+    .add_argument("-m")
+    .help(("map path"))
+    .default_value(std::string{"assets/base/map/calamity/map-calamity.json"})
+  ;
+
+  options
+    .add_argument("-t")
+    .help(("tick rate in Hz"))
+    .default_value(std::to_string(1000.0f/pul::util::MsPerFrame))
+  ;
+
+  options
+    .add_argument("-p")
+    .help(("port to host on"))
+    .default_value(std::to_string(pul::core::Config{}.networkPortAddress))
+  ;
+
+  options
+    .add_argument("-c")
+    .help(("maximum number of clients"))
+    .default_value(std::string{"16"})
+  ;
+
+  options
+    .add_argument("-b")
+    .help(("send budget per client in KiB/s (0 means unlimited)"))
+    .default_value(std::string{"0"})
+  ;
+
+  options
+    .add_argument("-a")
+    .help(("asset directory clients download (empty means none)"))
+    .default_value(std::string{""})
+  ;
+
+  options
+    .add_argument("-n")
+    .help(("stop after this many ticks (0 means never)"))
+    .default_value(std::string{"0"})
+  ;
+
+  options
+    .add_argument("-j")
+    .help(("job worker threads, e.g. for animation (0 means the tick thread)"))
+    .default_value(std::string{"0"})
+  ;
+
+  options
+    .add_argument("-d")
+    .help("debug mode (console printing)")
+    .default_value(false)
+    .implicit_value(true)
+  ;
+
+  return options;
+}
+
+auto CreateServerConfig(
+  argparse::ArgumentParser const & userResults
+, pul::core::SimulationClock & clock
+) -> pul::core::Config
+{
+  pul::core::Config config;
+  config.headless = true;
+
+  try {
+    config.mapPath = std::filesystem::path{userResults.get<std::string>("-m")};
+    clock.SetTickRate(std::stof(userResults.get<std::string>("-t")));
+    ::assetPath = std::filesystem::path{userResults.get<std::string>("-a")};
+    ::tickLimit = std::stoul(userResults.get<std::string>("-n"));
+    ::maxClients = std::stoul(userResults.get<std::string>("-c"));
+    ::clientSendBudget =
+      std::stoul(userResults.get<std::string>("-b")) * 1024ul;
+    config.networkPortAddress =
+      static_cast<uint16_t>(std::stoul(userResults.get<std::string>("-p")));
+    config.jobWorkerCount = std::stoul(userResults.get<std::string>("-j"));
+    if (userResults.get<bool>("-d")) {
+      spdlog::set_level(spdlog::level::debug);
+    }
+  } catch (const std::exception & err) {
+    spdlog::critical("{}", err.what());
+  }
+
+  return config;
+}
+
+auto FindClient(ENetPeer const * peer) {
+  return
+    std::find_if(
+      ::clients.begin(), ::clients.end()
+    , [peer](auto const & client) { return client.peer == peer; }
+    );
+}
+
+// this runs once per tick of the simulation clock
+void ProcessLogic(
+  pul::plugin::Info const & plugin, pul::core::SceneBundle & scene
+) {
+  ++ scene.clock.tick;
+
+  // nothing renders the debug physics queries, but they still get recorded
+  auto & queries = scene.PhysicsDebugQueries();
+  queries.intersectorRays.clear();
+  queries.intersectorPoints.clear();
+
+  // every client player runs one input per tick, if none arrived in time the
+  // previous one is held
+  for (auto & client : ::clients) {
+    if (client.inputs.empty()) {
+      plugin.ApplyNetworkPlayerInput(scene, client.playerNetworkId, nullptr);
+      continue;
+    }
+
+    plugin.ApplyNetworkPlayerInput(
+      scene, client.playerNetworkId, &client.inputs.front()
+    );
+    client.inputTick = client.inputs.front().tick;
+    client.inputs.pop_front();
+  }
+
+  plugin.LogicUpdate(scene);
+}
+
+void ReceiveInput(pul::network::Event & event) {
+  auto client = ::FindClient(event.peer);
+  if (client == ::clients.end()) { return; }
+
+  auto reader = pul::network::PacketReader::Construct(event.packet);
+  pul::network::PacketPlayerInput input;
+  if (!pul::network::ReadPacket(reader, input) || !reader.Finished()) {
+    spdlog::error("malformed input");
+    return;
+  }
+
+  // inputs are unreliable, anything out of order is too late to be simulated
+  uint32_t const newestTick =
+    client->inputs.empty() ? client->inputTick : client->inputs.back().tick;
+  if (
+      newestTick != pul::network::PacketSnapshot::NoBaseline
+   && input.tick <= newestTick
+  ) {
+    return;
+  }
+
+  client->inputs.emplace_back(input);
+  if (client->inputs.size() > ::maxQueuedInputs)
+    { client->inputs.pop_front(); }
+}
+
+void ReceiveSnapshotAck(
+  pul::core::SceneBundle const & scene, pul::network::Event & event
+) {
+  auto client = ::FindClient(event.peer);
+  if (client == ::clients.end()) { return; }
+
+  auto reader = pul::network::PacketReader::Construct(event.packet);
+  pul::network::PacketSnapshotAck ack;
+  if (!pul::network::ReadPacket(reader, ack) || !reader.Finished()) {
+    spdlog::error("malformed snapshot ack");
+    return;
+  }
+
+  // only a snapshot the server still has can be a baseline, anything else is
+  // bogus and would leave the client on full snapshots for good
+  if (
+      ack.tick > static_cast<uint32_t>(scene.clock.tick)
+   || !::snapshotHistory.Find(ack.tick)
+  ) {
+    return;
+  }
+
+  // acks are unsequenced, only ever move forward
+  if (
+      client->ackedTick == pul::network::PacketSnapshot::NoBaseline
+   || ack.tick > client->ackedTick
+  ) {
+    client->ackedTick = ack.tick;
+  }
+}
+
+void ReceivePacket(
+  pul::core::SceneBundle const & scene, pul::network::Event & event
+) {
+  switch (event.type) {
+    default:
+      spdlog::error("unexpected packet {}", ToString(event.type));
+    break;
+    case pul::network::PacketType::FileChunkRequest:
+      if (::fileTransfer.Valid())
+        { ::fileTransfer.ReceiveChunkRequest(event); }
+    break;
+    case pul::network::PacketType::PlayerInput:
+      ::ReceiveInput(event);
+    break;
+    case pul::network::PacketType::SnapshotAck:
+      ::ReceiveSnapshotAck(scene, event);
+    break;
+  }
+}
+
+// every client gets the snapshot of this tick delta compressed against the
+// last one it acknowledged, or in full if that one is no longer around.
+// Clients that acknowledged the same snapshot share the same delta, so it is
+// encoded once per baseline and only copied behind each client's header
+void SendSnapshots(
+  pul::plugin::Info const & plugin
+, pul::core::SceneBundle & scene
+, pul::network::ServerHost & server
+) {
+  auto const tick = static_cast<uint32_t>(scene.clock.tick);
+
+  auto & snapshot = ::snapshotHistory.Store(tick);
+  plugin.CaptureSnapshot(scene, snapshot);
+
+  // (baseline tick, encoded delta) of this tick, the buffers are kept around
+  static std::vector<std::pair<uint32_t, std::vector<uint8_t>>> payloads;
+  size_t payloadCount = 0ul;
+
+  auto const encodePayload =
+    [&](
+      uint32_t const baselineTick, pul::network::Snapshot const * baseline
+    ) -> std::vector<uint8_t> const & {
+      for (size_t idx = 0ul; idx < payloadCount; ++ idx) {
+        if (payloads[idx].first == baselineTick)
+          { return payloads[idx].second; }
+      }
+
+      if (payloadCount == payloads.size()) { payloads.emplace_back(); }
+      auto & payload = payloads[payloadCount ++];
+      payload.first = baselineTick;
+
+      auto writer = pul::network::PacketWriter::ConstructBuffer(payload.second);
+      pul::network::EncodeSnapshotDelta(baseline, snapshot, writer);
+      return payload.second;
+    };
+
+  for (auto & client : ::clients) {
+    pul::network::PacketSnapshot header;
+    header.tick = tick;
+
+    pul::network::Snapshot const * baseline = nullptr;
+    if (client.ackedTick != pul::network::PacketSnapshot::NoBaseline)
+      { baseline = ::snapshotHistory.Find(client.ackedTick); }
+
+    if (baseline)
+      { header.baselineTick = client.ackedTick; }
+
+    header.playerNetworkId = client.playerNetworkId;
+    header.inputTick = client.inputTick;
+
+    auto const & payload = encodePayload(header.baselineTick, baseline);
+
+    // the header is at most a few varints
+    auto writer =
+      pul::network::PacketWriter::Construct(
+        pul::network::PacketSnapshot::packetType
+      , pul::network::ChannelType::Unreliable
+      , 32ul + payload.size()
+      );
+    pul::network::WritePacket(writer, header);
+    writer.WriteBytes(payload.data(), payload.size());
+    server.Send(writer.Finish(), client.peer);
+  }
+}
+
+pul::plugin::Info InitializePlugins() {
+  pul::plugin::Info plugins;
+
+  pul::plugin::LoadPlugin(plugins , "plugins/plugin-base.pulcher-plugin");
+
+  return plugins;
+}
+
+} // -- anon namespace
+
+int main(int argc, char const ** argv) {
+
+  spdlog::set_pattern("%^%M:%S |%$ %v");
+
+  pul::core::SceneBundle sceneBundle;
+
+  { // -- collect user options
+    auto options = ::StartupOptions();
+
+    options.parse_args(argc, argv);
+
+    sceneBundle.config = ::CreateServerConfig(options, sceneBundle.clock);
+  }
+
+  std::signal(SIGINT,  [](int) { ::shutdownRequested = 1; });
+  std::signal(SIGTERM, [](int) { ::shutdownRequested = 1; });
+
+  spdlog::info("initializing pulcher server");
+  spdlog::info("tick rate {:.1f} Hz", sceneBundle.clock.TickRate());
+
+  pul::plugin::Info plugin = InitializePlugins();
+
+  plugin.Initialize(sceneBundle);
+
+  auto network = pul::network::Network::Construct();
+  if (!network.valid) {
+    spdlog::critical("could not initialize network");
+    return 1;
+  }
+
+  if (!::assetPath.empty()) {
+    ::fileTransfer = pul::network::FileTransferServer::Construct(::assetPath);
+  }
+
+  pul::network::ServerHost server;
+  { // -- host
+    pul::network::ServerHost::ConstructInfo ci;
+    ci.port = sceneBundle.config.networkPortAddress;
+    ci.maxConnections = ::maxClients;
+    ci.clientSendBudget = ::clientSendBudget;
+    ci.fnConnect =
+      [&plugin, &sceneBundle, &server](pul::network::Event & event) {
+        auto & client = ::clients.emplace_back();
+        client.peer = event.peer;
+        client.playerNetworkId = plugin.ConstructNetworkPlayer(sceneBundle);
+        spdlog::info("client connected as player {}", client.playerNetworkId);
+
+        // the client requests whatever it is missing from this
+        if (::fileTransfer.Valid())
+          { ::fileTransfer.SendManifest(server, event.peer); }
+      };
+    ci.fnDisconnect = [&plugin, &sceneBundle](pul::network::Event & event) {
+      spdlog::info("client disconnected");
+      ::fileTransfer.Disconnect(event.peer);
+      if (auto client = ::FindClient(event.peer); client != ::clients.end()) {
+        plugin.DestroyNetworkPlayer(sceneBundle, client->playerNetworkId);
+        ::clients.erase(client);
+      }
+    };
+    ci.fnReceive = [&sceneBundle](pul::network::Event & event) {
+      ::ReceivePacket(sceneBundle, event);
+    };
+
+    server = pul::network::ServerHost::Construct(ci);
+  }
+
+  if (!server.Valid()) {
+    spdlog::critical(
+      "could not host on port {}", sceneBundle.config.networkPortAddress
+    );
+    return 1;
+  }
+
+  spdlog::info(
+    "hosting on port {} for up to {} clients"
+  , sceneBundle.config.networkPortAddress, ::maxClients
+  );
+
+  // ENet is serviced on its own thread from here on, so a burst of packets is
+  // queued up instead of holding up the tick
+  server.StartThread();
+
+  auto timePreviousTick = std::chrono::steady_clock::now();
+
+  while (!::shutdownRequested) {
+    auto const timeTick = std::chrono::steady_clock::now();
+    float const deltaMs =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+        timeTick - timePreviousTick
+      ).count() / 1000.0f;
+    timePreviousTick = timeTick;
+
+    // a stall this long is dropped instead of being caught up with, same as
+    // the client does
+    if (deltaMs < 100.0f) {
+      server.DispatchEvents();
+
+      if (::fileTransfer.Valid()) { ::fileTransfer.Update(server); }
+
+      size_t const ticks = sceneBundle.clock.Advance(deltaMs);
+      for (size_t tick = 0ul; tick < ticks; ++ tick) {
+        ::ProcessLogic(plugin, sceneBundle);
+      }
+
+      sceneBundle.numCpuFrames = ticks;
+
+      // only the newest state matters when catching up on several ticks
+      if (ticks > 0ul)
+        { ::SendSnapshots(plugin, sceneBundle, server); }
+    } else {
+      spdlog::warn("dropped {:.2f} ms of simulation", deltaMs);
+    }
+
+    if (::tickLimit > 0ul && sceneBundle.clock.tick >= ::tickLimit)
+      { break; }
+
+    // sleep off the rest of the tick, so an idle match does not spin a core
+    std::this_thread::sleep_for(
+      std::chrono::microseconds(
+        static_cast<int64_t>(sceneBundle.clock.MsUntilNextTick() * 1000.0f)
+      )
+    );
+  }
+
+  spdlog::info("shutting down after {} ticks", sceneBundle.clock.tick);
+
+  server.StopThread();
+
+  plugin.Shutdown(sceneBundle);
+
+  return 0;
+}
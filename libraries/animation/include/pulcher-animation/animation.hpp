@@ -8,6 +8,7 @@
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <string_view>
 #include <vector>
 
 namespace pul::animation {
@@ -35,10 +36,31 @@ namespace pul::animation {
     Pieces are connected together using "parent" and thus they get
     skeletal-esque animation as their offsets are compounded together.
 
-  TODO change std::string to size_t and use std::hash
+    Pieces & states are keyed by their label in the animator, which is what
+    the json & editor work with. Once loaded the animator indexes them in
+    label order, so an instance looks them up by index.
 
   */
 
+  // index of a piece or state that the animator does not have
+  constexpr uint32_t InvalidIdx = -1u;
+
+  // pieces that gameplay code refers to by name; each animator resolves them
+  // to its own piece indices when it is indexed, so that looking one of them
+  // up is an array index instead of a string lookup
+  enum struct PieceId : uint8_t {
+    Particle, Legs, Body, Head, ArmBack, ArmFront, WeaponPlaceholder, Weapons
+  , Pickups, PickupBg
+  , Size
+  };
+
+  constexpr std::array<
+    std::string_view, static_cast<size_t>(PieceId::Size)
+  > PieceIdLabels = {
+    "particle", "legs", "body", "head", "arm-back", "arm-front"
+  , "weapon-placeholder", "weapons", "pickups", "pickup-bg"
+  };
+
   struct Component {
     glm::u32vec2 tile = {};
     glm::i32vec2 originOffset = {};
@@ -117,6 +139,12 @@ namespace pul::animation {
 
     struct Piece {
       std::map<std::string, pul::animation::Animator::State> states = {};
+
+      // states in the order of `states`, see Animator::IndexPieces
+      std::vector<pul::animation::Animator::State *> stateList = {};
+
+      uint32_t StateIdx(std::string_view const label) const;
+
       glm::u32vec2 dimensions = {};
       glm::i32vec2 origin = {};
       int16_t renderDepth = 0; // valid from -127 .. 128
@@ -126,6 +154,9 @@ namespace pul::animation {
       std::string label;
       glm::i32vec2 origin = {};
       std::vector<SkeletalPiece> children = {};
+
+      // resolved from the label by Animator::IndexPieces
+      uint32_t pieceIdx = InvalidIdx;
     };
 
     // -- members
@@ -133,8 +164,24 @@ namespace pul::animation {
     std::map<std::string, pul::animation::Animator::Piece> pieces;
     std::vector<SkeletalPiece> skeleton;
     glm::uvec2 uvCoordOffset = glm::uvec2(0);
+
+    // atlas page of the animation system the spritesheet was packed into,
+    // with the texel its copy starts at; nullptr if it was not packed
+    pul::gfx::Spritesheet const * atlas = nullptr;
+    glm::uvec2 atlasOrigin = glm::uvec2(0);
     std::string label;
     std::string filename;
+
+    // pieces in the order of `pieces`, and the index of every PieceId
+    std::vector<pul::animation::Animator::Piece *> pieceList;
+    std::array<uint32_t, static_cast<size_t>(PieceId::Size)> pieceIdIndices =
+      {};
+
+    // has to be called again whenever a piece, state or skeletal piece is
+    // added or removed, as that moves the indices
+    void IndexPieces();
+
+    uint32_t PieceIdx(std::string_view const label) const;
   };
 
   struct System {
@@ -145,6 +192,10 @@ namespace pul::animation {
 
     std::unique_ptr<pul::gfx::SgBuffer> sgBuffer = {};
     sg_bindings sgBindings = {};
+
+    // the animator spritesheets packed together, so that instances of
+    // different animators can be drawn with the same texture bound
+    std::vector<std::unique_ptr<pul::gfx::Spritesheet>> atlases;
   };
 
   struct Instance {
@@ -166,14 +217,97 @@ namespace pul::animation {
       std::shared_ptr<Animator> animator;
       std::string pieceLabel;
 
+      // indices of pieceLabel & label in the animator
+      uint32_t pieceIdx = InvalidIdx;
+      uint32_t stateIdx = InvalidIdx;
+
       VariationRuntimeInfo variationRti = {};
 
       glm::mat3 cachedLocalSkeletalMatrix = glm::mat3(0.0f);
 
-      void Apply(std::string const & nLabel, bool force = false);
+      // what the cached matrix & the vertices of the piece were last computed
+      // from, the piece is only computed again once one of these changes.
+      // Defaults to inputs no piece has, so that a new piece is computed
+      struct CacheInputs {
+        glm::mat3 skeletalMatrix = glm::mat3(0.0f);
+        std::vector<Component> const * components = nullptr;
+        size_t componentIt = -1ul;
+        float deltaTime = 0.0f;
+        float skeletalRotation = 0.0f;
+        bool skeletalFlip = false;
+
+        bool operator==(CacheInputs const &) const = default;
+      };
+
+      struct VertexInputs {
+        glm::mat3 skeletalMatrix = glm::mat3(0.0f);
+        std::vector<Component> const * components = nullptr;
+        size_t componentIt = -1ul;
+        glm::vec2 uvCoordWrap = glm::vec2(0.0f);
+        glm::vec2 vertWrap = glm::vec2(0.0f);
+        bool skeletalFlip = false;
+        bool flipVertWrap = false;
+        bool visible = false;
+
+        bool operator==(VertexInputs const &) const = default;
+      };
+
+      CacheInputs cacheInputs = {};
+      VertexInputs vertexInputs = {};
+
+      void Apply(std::string_view const nLabel, bool force = false);
+    };
+
+    // the state of every piece of the animator, by piece index
+    struct PieceStates {
+      Animator const * animator = nullptr;
+      std::vector<StateInfo> states = {};
+
+      // stands in for pieces the animator does not have, so what is written
+      // to those is never rendered
+      StateInfo unknown = {};
+
+      uint32_t PieceIdx(PieceId const piece) const {
+        return
+          animator
+            ? animator->pieceIdIndices[static_cast<size_t>(piece)]
+            : InvalidIdx
+        ;
+      }
+
+      StateInfo & operator[](PieceId const piece) {
+        return this->AtIdx(this->PieceIdx(piece));
+      }
+
+      // for labels that are not a PieceId, this looks the label up
+      StateInfo & operator[](std::string_view const piece) {
+        return this->AtIdx(animator ? animator->PieceIdx(piece) : InvalidIdx);
+      }
+
+      StateInfo & AtIdx(uint32_t const pieceIdx) {
+        return pieceIdx < states.size() ? states[pieceIdx] : unknown;
+      }
+
+      StateInfo const & operator[](PieceId const piece) const {
+        return this->AtIdx(this->PieceIdx(piece));
+      }
+
+      StateInfo const & AtIdx(uint32_t const pieceIdx) const {
+        return pieceIdx < states.size() ? states[pieceIdx] : unknown;
+      }
+
+      StateInfo const * Find(PieceId const piece) const {
+        uint32_t const pieceIdx = this->PieceIdx(piece);
+        return pieceIdx < states.size() ? &states[pieceIdx] : nullptr;
+      }
+
+      auto begin() { return states.begin(); }
+      auto end() { return states.end(); }
+      auto begin() const { return states.begin(); }
+      auto end() const { return states.end(); }
     };
 
-    std::map<std::string, StateInfo> pieceToState = {};
+    PieceStates pieceToState = {};
 
     // if set to false, the matrix will no longer be recalculated every render
     // frame. This allows an animation matrix to not have to be set every frame
@@ -187,6 +321,10 @@ namespace pul::animation {
 
     bool visible = true;
 
+    // texture the uv coords were computed against; the animator's atlas page,
+    // or its own spritesheet
+    pul::gfx::Spritesheet const * spritesheet = nullptr;
+
     // keep origin/uv coord buffer data around for streaming updates
     std::vector<glm::vec2> uvCoordBufferData = {};
     std::vector<glm::vec3> originBufferData = {};
@@ -2,6 +2,22 @@
 
 #include <pulcher-util/log.hpp>
 
+#include <iterator>
+
+namespace {
+
+void IndexSkeleton(
+  pul::animation::Animator const & animator
+, std::vector<pul::animation::Animator::SkeletalPiece> & skeletals
+) {
+  for (auto & skeletal : skeletals) {
+    skeletal.pieceIdx = animator.PieceIdx(skeletal.label);
+    ::IndexSkeleton(animator, skeletal.children);
+  }
+}
+
+} // -- namespace
+
 size_t pul::animation::Animator::State::VariationIdxLookup(
   VariationRuntimeInfo const & variationRti
 ) {
@@ -53,18 +69,64 @@ pul::animation::Animator::State::ComponentLookup(
   }
 }
 
+uint32_t pul::animation::Animator::Piece::StateIdx(
+  std::string_view const label
+) const {
+  auto const state = this->states.find(std::string{label});
+  if (state == this->states.end()) { return pul::animation::InvalidIdx; }
+  return
+    static_cast<uint32_t>(std::distance(this->states.begin(), state));
+}
+
+void pul::animation::Animator::IndexPieces() {
+  this->pieceList.clear();
+  for (auto & piecePair : this->pieces) {
+    auto & piece = std::get<1>(piecePair);
+    piece.stateList.clear();
+    for (auto & statePair : piece.states)
+      { piece.stateList.emplace_back(&std::get<1>(statePair)); }
+
+    this->pieceList.emplace_back(&piece);
+  }
+
+  for (size_t it = 0ul; it < this->pieceIdIndices.size(); ++ it)
+    { this->pieceIdIndices[it] = this->PieceIdx(PieceIdLabels[it]); }
+
+  ::IndexSkeleton(*this, this->skeleton);
+}
+
+uint32_t pul::animation::Animator::PieceIdx(
+  std::string_view const label
+) const {
+  auto const piece = this->pieces.find(std::string{label});
+  if (piece == this->pieces.end()) { return pul::animation::InvalidIdx; }
+  return
+    static_cast<uint32_t>(std::distance(this->pieces.begin(), piece));
+}
+
 void pul::animation::Instance::StateInfo::Apply(
-  std::string const & nLabel, bool force
+  std::string_view const nLabel, bool force
 ) {
   if (!force && label == nLabel) { return; }
-  label = nLabel;
+  label = std::string{nLabel};
   deltaTime = 0.0f;
   componentIt = 0ul;
   animationFinished = false;
 
   variationRti = {};
 
-  auto const & state = animator->pieces[pieceLabel].states[label];
+  // the animator is shared with other instances, so it is only read from
+  stateIdx = pul::animation::InvalidIdx;
+  if (!animator || pieceIdx >= animator->pieceList.size()) { return; }
+
+  auto const & piece = *animator->pieceList[pieceIdx];
+  stateIdx = piece.StateIdx(label);
+  if (stateIdx == pul::animation::InvalidIdx) {
+    spdlog::error("unknown state '{}' of piece '{}'", label, pieceLabel);
+    return;
+  }
+
+  auto const & state = *piece.stateList[stateIdx];
 
   switch (state.variationType) {
     default: spdlog::error("variation type default"); break;
@@ -56,10 +56,11 @@ namespace pul::audio {
 
     // creates audio event, returns an RAII structure where you can make
     // changes to the instance before it gets released (audio will still play)
+    // does nothing if the system has not been initialized
     EventInstance DispatchEventOneOff(pul::audio::EventInfo const & event);
 
-    FMOD_STUDIO_SYSTEM * fmodSystem;
-    FMOD_STUDIO_BANK * fmodBank;
+    FMOD_STUDIO_SYSTEM * fmodSystem = nullptr;
+    FMOD_STUDIO_BANK * fmodBank = nullptr;
 
     void Initialize();
     void Shutdown();
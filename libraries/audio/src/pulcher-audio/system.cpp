@@ -30,6 +30,8 @@ size_t pul::audio::System::DispatchEvent(pul::audio::EventInfo const &) {
 pul::audio::EventInstance pul::audio::System::DispatchEventOneOff(
   pul::audio::EventInfo const & event
 ) {
+  if (!this->fmodSystem) { return {}; }
+
   auto const & description = this->eventDescriptions[Idx(event.event)];
 
   FMOD_STUDIO_EVENTINSTANCE * instance = nullptr;
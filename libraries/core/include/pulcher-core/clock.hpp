@@ -0,0 +1,55 @@
+#pragma once
+
+#include <pulcher-util/consts.hpp>
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+
+namespace pul::core {
+  // fixed timestep the logic is simulated with. Gameplay is tuned against
+  // pul::util::MsPerFrame, so velocities are in pixels per tuning frame;
+  // anything integrated per tick is scaled by TickScale to keep the
+  // simulation the same at every tick rate
+  struct SimulationClock {
+    // simulated ms of a single tick
+    float tickMs = pul::util::MsPerFrame;
+
+    // real ms it takes to simulate one ms, only to slow down or speed up the
+    // simulation for debugging
+    float timeScale = 1.0f;
+
+    // real ms accumulated that have not been simulated yet
+    float accumulatedMs = 0.0f;
+
+    // ticks simulated since construction, incremented by whoever simulates
+    // the tick so it is exact while several ticks run in one frame; clients
+    // identify their inputs by it
+    size_t tick = 0ul;
+
+    // bodies that move further than maxSubstepDistance pixels in a tick are
+    // integrated over multiple substeps, at most maxSubsteps
+    bool adaptiveSubsteps = true;
+    float maxSubstepDistance = 16.0f;
+    size_t maxSubsteps = 8ul;
+
+    void SetTickRate(float const ticksPerSecond);
+    float TickRate() const;
+
+    // length of a tick relative to the tuning frame
+    float TickScale() const;
+
+    // accumulates real time, returns the amount of ticks to simulate
+    size_t Advance(float const deltaMs);
+
+    // 0 .. 1, how far real time has progressed into the next tick
+    float Interpolation() const;
+
+    // real ms left until the next tick is due
+    float MsUntilNextTick() const;
+
+    // amount of substeps a body moving by displacement this tick is
+    // integrated with
+    size_t Substeps(glm::vec2 const & displacement) const;
+  };
+}
@@ -2,6 +2,7 @@
 
 #include <array>
 #include <filesystem>
+#include <optional>
 #include <string>
 
 namespace pul::core {
@@ -12,5 +13,14 @@ namespace pul::core {
     uint16_t windowWidth = 0ul, windowHeight = 0ul;
     glm::u16vec2 framebufferDim;
     glm::vec2 framebufferDimFloat;
+
+    // no window, GPU or audio device exists; only the logic is simulated, as
+    // done by pulcher-server
+    bool headless = false;
+
+    // worker threads of the job pool, the thread submitting jobs helps with
+    // them too so 0 runs every job there. Unset is one less than the hardware
+    // threads, or 0 if headless as many instances may share a machine
+    std::optional<size_t> jobWorkerCount;
   };
 }
@@ -26,7 +26,9 @@ namespace pul::core {
     bool physicsBound = false;
     bool gravityAffected = false;
 
-    std::function<void(glm::vec2 & velocity)> velocityModifierFn = {};
+    // called every tick with the ms simulated
+    std::function<void(glm::vec2 & velocity, float const msElapsed)>
+      velocityModifierFn = {};
   };
 
   struct ComponentHitscanProjectile {
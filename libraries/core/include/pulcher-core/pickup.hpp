@@ -14,7 +14,7 @@ namespace pul::core {
     glm::vec2 origin;
 
     bool spawned;
-    size_t spawnTimer;
+    float spawnTimer = 0.0f;
     size_t spawnTimerSet = 5000ul;
   };
 }
@@ -34,7 +34,6 @@ namespace pul::core {
   struct ComponentPlayer {
     glm::vec2 velocity = {};
     glm::vec2 storedVelocity = {};
-    glm::vec2 prevOrigin = {};
     float lookAtAngle = 0.0f;
     bool flip = false;
 
@@ -83,6 +82,13 @@ namespace pul::core {
   struct ComponentPlayerControllable { };
   struct ComponentBotControllable { };
 
+  // controlled by the inputs a client sends to the server
+  struct ComponentNetworkControllable {
+    // how far behind the server the client saw the world with its most
+    // recent input, hitscans of the player are tested that far back
+    float rewindMs = 0.0f;
+  };
+
   struct ComponentCamera {
   };
 
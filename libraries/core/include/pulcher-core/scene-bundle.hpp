@@ -1,5 +1,6 @@
 #pragma once
 
+#include <pulcher-core/clock.hpp>
 #include <pulcher-core/config.hpp>
 #include <pulcher-util/any.hpp>
 #include <pulcher-util/consts.hpp>
@@ -21,13 +22,16 @@ namespace pul::core { struct HudInfo; }
 namespace pul::core { struct PlayerMetaInfo; }
 namespace pul::physics { struct DebugQueries; }
 namespace pul::plugin { struct Info; }
+namespace pul::util { struct JobPool; }
 
 namespace pul::core {
   struct SceneBundle {
     glm::vec2 playerOrigin = {};
     glm::i32vec2 cameraOrigin = {};
 
-    float calculatedMsPerFrame = pul::util::MsPerFrame;
+    pul::core::SimulationClock clock = {};
+
+    // logic ticks simulated during the most recent rendered frame
     size_t numCpuFrames = 0ul;
 
     bool debugFrameBufferHovered = false;
@@ -42,6 +46,7 @@ namespace pul::core {
     pul::physics::DebugQueries & PhysicsDebugQueries();
     pul::audio::System & AudioSystem();
     pul::core::HudInfo & Hud();
+    pul::util::JobPool & JobPool();
 
 
     // store player between reloads
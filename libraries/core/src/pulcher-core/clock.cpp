@@ -0,0 +1,50 @@
+#include <pulcher-core/clock.hpp>
+
+void pul::core::SimulationClock::SetTickRate(float const ticksPerSecond) {
+  tickMs = 1000.0f / ticksPerSecond;
+}
+
+float pul::core::SimulationClock::TickRate() const {
+  return 1000.0f / tickMs;
+}
+
+float pul::core::SimulationClock::TickScale() const {
+  return tickMs / pul::util::MsPerFrame;
+}
+
+size_t pul::core::SimulationClock::Advance(float const deltaMs) {
+  accumulatedMs += deltaMs;
+
+  float const realTickMs = tickMs * timeScale;
+
+  size_t ticks = 0ul;
+  while (accumulatedMs >= realTickMs) {
+    accumulatedMs -= realTickMs;
+    ++ ticks;
+  }
+
+  return ticks;
+}
+
+float pul::core::SimulationClock::Interpolation() const {
+  return accumulatedMs / (tickMs * timeScale);
+}
+
+float pul::core::SimulationClock::MsUntilNextTick() const {
+  return glm::max(0.0f, tickMs * timeScale - accumulatedMs);
+}
+
+size_t pul::core::SimulationClock::Substeps(
+  glm::vec2 const & displacement
+) const {
+  if (!adaptiveSubsteps) { return 1ul; }
+
+  float const distance =
+    glm::max(glm::abs(displacement.x), glm::abs(displacement.y));
+
+  return
+    glm::clamp(
+      static_cast<size_t>(glm::ceil(distance / maxSubstepDistance))
+    , size_t{1}, maxSubsteps
+    );
+}
@@ -7,9 +7,12 @@
 #include <pulcher-core/player.hpp>
 #include <pulcher-physics/intersections.hpp>
 #include <pulcher-plugin/plugin.hpp>
+#include <pulcher-util/jobs.hpp>
 
 #include <entt/entt.hpp>
 
+#include <memory>
+
 struct pul::core::SceneBundle::Impl {
   pul::animation::System animationSystem;
   pul::audio::System audioSystem;
@@ -19,6 +22,7 @@ struct pul::core::SceneBundle::Impl {
   pul::core::ComponentPlayer storedDebugPlayerComponent;
   pul::core::ComponentOrigin storedDebugPlayerOriginComponent;
   pul::core::HudInfo hudInfo;
+  std::unique_ptr<pul::util::JobPool> jobPool;
 
   entt::registry enttRegistry;
 };
@@ -74,6 +78,23 @@ pul::core::HudInfo const & pul::core::SceneBundle::Hud() const {
   return impl->hudInfo;
 }
 
+pul::util::JobPool & pul::core::SceneBundle::JobPool() {
+  // created on first use, so that it is sized by the config that was loaded
+  // rather than the default one the scene was constructed with
+  if (!impl->jobPool) {
+    if (config.jobWorkerCount) {
+      impl->jobPool =
+        std::make_unique<pul::util::JobPool>(*config.jobWorkerCount);
+    } else if (config.headless) {
+      impl->jobPool = std::make_unique<pul::util::JobPool>(0ul);
+    } else {
+      impl->jobPool = std::make_unique<pul::util::JobPool>();
+    }
+  }
+
+  return *impl->jobPool;
+}
+
 entt::registry & pul::core::SceneBundle::EnttRegistry() {
   return impl->enttRegistry;
 }
@@ -7,8 +7,8 @@ struct sg_image;
 
 namespace pul::gfx {
   struct Spritesheet {
-    uint32_t handle;
-    size_t width, height;
+    uint32_t handle = 0u;
+    size_t width = 0ul, height = 0ul;
     std::string filename;
 
     Spritesheet() = default;
@@ -18,10 +18,14 @@ namespace pul::gfx {
     Spritesheet & operator=(Spritesheet const &) = delete;
     Spritesheet & operator=(Spritesheet &&);
 
-    static Spritesheet Construct(pul::gfx::Image const &);
+    // without uploading only the dimensions are kept, for when there is no
+    // GPU context to create the image on
+    static Spritesheet Construct(
+      pul::gfx::Image const &, bool const upload = true
+    );
 
     sg_image Image() const;
-    glm::vec2 InvResolution();
+    glm::vec2 InvResolution() const;
 
     void Destroy();
   };
@@ -27,7 +27,7 @@ pul::gfx::Spritesheet::operator=(Spritesheet && other) {
 }
 
 pul::gfx::Spritesheet pul::gfx::Spritesheet::Construct(
-  pul::gfx::Image const & image
+  pul::gfx::Image const & image, bool const upload
 ) {
   Spritesheet self;
 
@@ -35,6 +35,8 @@ pul::gfx::Spritesheet pul::gfx::Spritesheet::Construct(
   self.width = image.width;
   self.height = image.height;
 
+  if (!upload) { return self; }
+
   // setup image for sokol
   sg_image_desc desc = {};
   desc.type = SG_IMAGETYPE_2D;
@@ -68,7 +70,7 @@ sg_image pul::gfx::Spritesheet::Image() const {
   return image;
 }
 
-glm::vec2 pul::gfx::Spritesheet::InvResolution() {
+glm::vec2 pul::gfx::Spritesheet::InvResolution() const {
   return glm::vec2(1.0f) / glm::vec2(width, height);
 }
 
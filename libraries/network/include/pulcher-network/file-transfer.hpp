@@ -0,0 +1,140 @@
+#pragma once
+
+#include <pulcher-network/shared.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace pul::network { struct PacketReader; }
+namespace pul::network { struct PacketWriter; }
+
+namespace pul::network {
+
+  // files are transferred & compared in chunks of this many bytes, only the
+  // last chunk of a file is shorter
+  constexpr size_t FileChunkByteLength = 16384ul;
+
+  uint64_t HashChunk(uint8_t const * bytes, size_t const byteLength);
+
+  // every file under a directory with the hash of each of its chunks
+  struct FileManifest {
+    struct File {
+      // relative to the root of the manifest, '/' separated
+      std::string path;
+      uint64_t byteLength = 0ul;
+      std::vector<uint64_t> chunkHashes;
+    };
+
+    std::vector<File> files;
+
+    static FileManifest Construct(std::filesystem::path const & root);
+  };
+
+  void WriteManifest(PacketWriter & writer, FileManifest const & manifest);
+
+  // returns false if the manifest is malformed, or names a path that would
+  // leave the root it is downloaded into
+  bool ReadManifest(PacketReader & reader, FileManifest & manifest);
+
+  // serves the files under root to any number of clients. A client is sent
+  // the manifest and requests whichever chunks it does not have. Requested
+  // chunks are queued and served a few per Update, so a download never holds
+  // up the tick it was requested on
+  struct FileTransferServer {
+    // chunks read & sent per Update, shared by every client
+    static constexpr size_t MaxChunksPerUpdate = 16ul;
+
+    // requests past this many queued chunks are dropped, the client requests
+    // them again once they time out
+    static constexpr size_t MaxQueuedChunks = 1024ul;
+
+    std::filesystem::path root;
+    FileManifest manifest;
+
+    struct QueuedChunk {
+      ENetPeer * peer;
+      uint32_t fileIdx;
+      uint32_t chunkIdx;
+    };
+
+    std::deque<QueuedChunk> queuedChunks;
+
+    // the file chunks were last read from, requests tend to walk a file in
+    // order so it is kept open between chunks
+    std::ifstream stream;
+    uint32_t streamFileIdx = -1u;
+
+    static FileTransferServer Construct(std::filesystem::path const & root);
+
+    bool Valid() const { return !root.empty(); }
+
+    void SendManifest(ServerHost & server, ENetPeer * peer);
+
+    // queues the chunks named by a PacketType::FileChunkRequest
+    void ReceiveChunkRequest(Event & event);
+
+    // reads & sends queued chunks, up to MaxChunksPerUpdate
+    void Update(ServerHost & server);
+
+    // drops the chunks queued for the peer
+    void Disconnect(ENetPeer * peer);
+  };
+
+  // downloads the files of a server's manifest that differ from the ones
+  // under root. A file is written to "<path>.part" until all of its chunks
+  // are verified, chunks it shares with the previous version of the file are
+  // kept. After a disconnect the same manifest resumes from whatever chunks
+  // of the ".part" files are already correct. Several files are downloaded
+  // at once, up to a window of requested chunks
+  struct FileTransferClient {
+    static constexpr size_t MaxChunksInFlight = 64ul;
+    static constexpr size_t ChunksPerRequest = 16ul;
+
+    // requested chunks that have not arrived by then are requested again
+    static constexpr std::chrono::milliseconds RequestTimeout{2000};
+
+    std::filesystem::path root;
+    FileManifest manifest;
+
+    struct Chunk {
+      uint32_t fileIdx;
+      uint32_t chunkIdx;
+    };
+
+    struct RequestedChunk {
+      Chunk chunk;
+      std::chrono::steady_clock::time_point time;
+    };
+
+    std::deque<Chunk> missingChunks;
+    std::vector<RequestedChunk> requestedChunks;
+
+    // chunks left per file of the manifest
+    std::vector<size_t> remainingChunks;
+
+    size_t downloadedByteLength = 0ul;
+    size_t totalByteLength = 0ul;
+
+    // applies a PacketType::FileManifest, comparing it to the local files
+    void ReceiveManifest(Event & event);
+
+    // writes a PacketType::FileChunk if its hash matches the manifest
+    void ReceiveChunk(Event & event);
+
+    // requests missing chunks up to the window, and again once timed out
+    void Update(ClientHost & client);
+
+    // the requests in flight are lost with the connection, the ".part" files
+    // are kept for the next manifest
+    void Disconnect();
+
+    bool Finished() const {
+      return missingChunks.empty() && requestedChunks.empty();
+    }
+  };
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <pulcher-network/shared.hpp>
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace pul::network {
+
+  // serializes a packet straight into the buffer of an ENetPacket, which is
+  // grown as needed and trimmed to the written length once finished. Integers
+  // can be written as varints and small values bit-packed; a byte aligned
+  // write after bits starts on the next byte
+  struct PacketWriter {
+    PacketWriter();
+    ~PacketWriter();
+    PacketWriter(PacketWriter && rval);
+    PacketWriter(PacketWriter const &) = delete;
+    PacketWriter & operator=(PacketWriter && rval);
+    PacketWriter & operator=(PacketWriter const &) = delete;
+
+    // the packet type is written first, as a plain PacketType, so that
+    // Host::ManualPollEvent can tell what the packet is
+    static PacketWriter Construct(
+      pul::network::PacketType const type
+    , pul::network::ChannelType const channel
+    , size_t const reserveByteLength = 64ul
+    );
+
+    // writes into bytes instead of a packet; to encode a payload once that is
+    // then copied into the packets of many peers
+    static PacketWriter ConstructBuffer(std::vector<uint8_t> & bytes);
+
+    void WriteBytes(void const * data, size_t const byteLength);
+
+    template <typename T> void Write(T const & value) {
+      static_assert(std::is_trivially_copyable_v<T>);
+      this->WriteBytes(&value, sizeof(T));
+    }
+
+    // LEB128, small values take a single byte
+    void WriteVarint(uint64_t const value);
+
+    // zigzag encoded, so small negative values are small too
+    void WriteVarintSigned(int64_t const value);
+
+    void WriteBits(uint32_t const value, uint32_t const bitCount);
+    void WriteBool(bool const value);
+
+    // length prefixed, without a terminator
+    void WriteString(std::string_view const string);
+
+    size_t ByteLength() const { return byteLength; }
+
+    // the packet trimmed to what was written, the writer is empty afterwards
+    pul::network::OutgoingPacket Finish();
+
+    pul::network::OutgoingPacket packet;
+    std::vector<uint8_t> * buffer = nullptr;
+
+    size_t byteLength = 0ul;
+    size_t byteCapacity = 0ul;
+
+    // bits of the last byte already written to, 0 when byte aligned
+    uint32_t bitsUsed = 0u;
+
+  private:
+    // pointer to byteLength more bytes at the end of the packet
+    uint8_t * Grow(size_t const length);
+  };
+
+  // reads a packet in place, views into it are valid as long as the packet
+  // is. Every read returns false once the packet is exhausted, and a byte
+  // aligned read after bits starts on the next byte
+  struct PacketReader {
+    // reads the packet past its type, which the event already knows
+    static PacketReader Construct(pul::network::IncomingPacket const & packet);
+
+    static PacketReader Construct(void const * bytes, size_t const byteLength);
+
+    bool ReadBytes(void * data, size_t const length);
+    bool ViewBytes(size_t const length, std::span<uint8_t const> & view);
+
+    template <typename T> bool Read(T & value) {
+      static_assert(std::is_trivially_copyable_v<T>);
+      return this->ReadBytes(&value, sizeof(T));
+    }
+
+    bool ReadVarint(uint64_t & value);
+    bool ReadVarint(uint32_t & value);
+    bool ReadVarintSigned(int64_t & value);
+
+    bool ReadBits(uint32_t & value, uint32_t const bitCount);
+    bool ReadBool(bool & value);
+
+    bool ReadString(std::string_view & string);
+
+    // true once every byte has been read
+    bool Finished() const { return offset == byteLength; }
+
+    uint8_t const * bytes = nullptr;
+    size_t byteLength = 0ul;
+    size_t offset = 0ul;
+
+    // bits of the last byte already read from, 0 when byte aligned
+    uint32_t bitsUsed = 0u;
+  };
+
+  // -- serialization of the variable-length packets; written after the
+  //    packet type by the caller, read past it
+
+  void WritePacket(PacketWriter & writer, PacketSnapshot const & packet);
+  bool ReadPacket(PacketReader & reader, PacketSnapshot & packet);
+
+  void WritePacket(PacketWriter & writer, PacketSnapshotAck const & packet);
+  bool ReadPacket(PacketReader & reader, PacketSnapshotAck & packet);
+
+  void WritePacket(PacketWriter & writer, PacketPlayerInput const & packet);
+  bool ReadPacket(PacketReader & reader, PacketPlayerInput & packet);
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace pul::network {
+
+  // bounded lock-free queue between exactly one producer thread and one
+  // consumer thread; neither side ever blocks, a full queue refuses the push
+  template <typename T, size_t Capacity>
+  struct SpscQueue {
+    static_assert(Capacity > 0ul && (Capacity & (Capacity - 1ul)) == 0ul);
+
+    // producer only
+    bool Push(T && value) {
+      size_t const pushIdx = this->tail.load(std::memory_order_relaxed);
+      if (pushIdx - this->head.load(std::memory_order_acquire) == Capacity)
+        { return false; }
+
+      this->items[pushIdx & (Capacity - 1ul)] = std::move(value);
+      this->tail.store(pushIdx + 1ul, std::memory_order_release);
+      return true;
+    }
+
+    // consumer only
+    bool Pop(T & value) {
+      size_t const popIdx = this->head.load(std::memory_order_relaxed);
+      if (popIdx == this->tail.load(std::memory_order_acquire))
+        { return false; }
+
+      value = std::move(this->items[popIdx & (Capacity - 1ul)]);
+      this->head.store(popIdx + 1ul, std::memory_order_release);
+      return true;
+    }
+
+    std::array<T, Capacity> items;
+
+    // kept on separate cache lines so the two threads do not contend
+    alignas(64) std::atomic<size_t> head = 0ul;
+    alignas(64) std::atomic<size_t> tail = 0ul;
+  };
+}
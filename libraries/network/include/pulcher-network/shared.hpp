@@ -5,6 +5,9 @@
 #include <array>
 #include <cstdint>
 #include <functional>
+#include <memory>
+#include <span>
+#include <string_view>
 
 namespace pul::network {
 
@@ -20,8 +23,12 @@ namespace pul::network {
   enum struct PacketType : uint16_t {
     SystemInfo
   , NetworkClientUpdate
-  , StreamStart
-  , StreamBlock
+  , FileManifest
+  , FileChunkRequest
+  , FileChunk
+  , Snapshot
+  , SnapshotAck
+  , PlayerInput
   };
 
   struct Network {
@@ -132,11 +139,33 @@ namespace pul::network {
     }
   };
 
+  // order in which the packets queued for a client are sent while its send
+  // budget is exhausted
+  enum struct SendPriority : uint8_t {
+    Low, Normal, High
+  , Size
+  };
+
+  struct OutgoingPacket;
+  struct ServerThread;
+
   struct ServerHost {
+    ServerHost();
+    ~ServerHost();
+    ServerHost(ServerHost && rval);
+    ServerHost(ServerHost const &) = delete;
+    ServerHost & operator=(ServerHost && rval);
+    ServerHost & operator=(ServerHost const &) = delete;
+
     Host host;
 
     struct ConstructInfo {
       uint32_t port;
+      size_t maxConnections = 16ul;
+
+      // bytes per second each client is sent at most, 0 for no limit
+      size_t clientSendBudget = 0ul;
+
       std::function<void(pul::network::Event & event)>
         fnConnect, fnReceive, fnDisconnect;
     };
@@ -144,6 +173,32 @@ namespace pul::network {
     static pul::network::ServerHost Construct(ConstructInfo const & ci);
 
     bool Valid() const { return this->host.Valid(); }
+
+    // services the host on a network thread, which hands the events it
+    // receives to DispatchEvents and sends what is queued with Send. From then
+    // on the host must not be used directly until StopThread
+    void StartThread();
+    void StopThread();
+
+    // calls fnConnect, fnReceive & fnDisconnect for every event the network
+    // thread has received so far, never waits for more. Without the thread
+    // this polls the host instead
+    void DispatchEvents();
+
+    // queues the packet for the network thread, a packet goes to a single
+    // peer. Each client is sent its packets in order of priority as long as
+    // it has budget left; reliable and streaming packets wait for more budget
+    // while unreliable ones are dropped, as a newer one follows anyways.
+    // Without the thread the packet is sent right away
+    void Send(
+      pul::network::OutgoingPacket const & packet
+    , ENetPeer * peer
+    , pul::network::SendPriority const priority =
+        pul::network::SendPriority::Normal
+    );
+
+    std::unique_ptr<ServerThread> thread;
+    size_t clientSendBudget = 0ul;
   };
 
   struct OutgoingPacket {
@@ -155,7 +210,14 @@ namespace pul::network {
       T const & data, pul::network::ChannelType channel
     );
 
+    // for packets that are not a fixed-size structure
+    static OutgoingPacket ConstructBytes(
+      void const * data, size_t const byteLength
+    , pul::network::ChannelType channel
+    );
+
     void Send(ClientHost & client);
+    void Send(ENetPeer * peer);
     void Broadcast(ServerHost & server);
   };
 
@@ -193,20 +255,58 @@ namespace pul::network {
     Type type;
   };
 
-  struct PacketFileStreamStart {
-    PacketType const packetType = PacketType::StreamStart;
+  // -- variable-length packets, serialized with pulcher-network/packet.hpp;
+  //    views point into the received packet
 
-    std::array<char, 1024ul> filename;
-    size_t incomingPacketLength;
-    uint16_t lastPacketLength;
+  // followed by the snapshot delta encoded against baselineTick, see
+  // pulcher-network/snapshot.hpp
+  struct PacketSnapshot {
+    static constexpr PacketType packetType = PacketType::Snapshot;
+
+    static constexpr uint32_t NoBaseline = -1u;
+
+    uint32_t tick;
+    uint32_t baselineTick = NoBaseline;
+
+    // the player the receiving client controls, and the tick of its newest
+    // input the server has simulated; the client predicts everything after
+    static constexpr uint32_t NoPlayer = -1u;
+    uint32_t playerNetworkId = NoPlayer;
+    uint32_t inputTick = NoBaseline;
+  };
+
+  struct PacketSnapshotAck {
+    static constexpr PacketType packetType = PacketType::SnapshotAck;
+
+    uint32_t tick;
   };
 
-  constexpr size_t StreamBlockByteLength = 4096ul;
+  // the input of a single client tick, what is left of
+  // pul::controls::Controller::Frame once the locally cached state is gone.
+  // Packed & unpacked by the plugin, which knows the controls
+  struct PacketPlayerInput {
+    static constexpr PacketType packetType = PacketType::PlayerInput;
+
+    enum struct Button : uint16_t {
+      Jump, Dash, Crouch, Walk, Taunt, ShootPrimary, ShootSecondary
+    , Size
+    };
+
+    static constexpr uint8_t NoWeaponSwitch = 0xFFu;
+
+    uint32_t tick;
+
+    // newest server snapshot the client had applied when running the input
+    uint32_t viewTick = PacketSnapshot::NoBaseline;
 
-  struct PacketFileStreamBlock {
-    PacketType const packetType = PacketType::StreamBlock;
+    uint16_t buttons = 0u;
+    int8_t movementHorizontal = 0, movementVertical = 0;
+    uint8_t movementDirection = 0u;
+    uint8_t weaponSwitchToType = NoWeaponSwitch;
+    int16_t weaponSwitch = 0;
 
-    std::array<uint8_t, StreamBlockByteLength> data;
+    std::array<float, 2> lookDirection = {}, lookOffset = {};
+    float lookAngle = 0.0f;
   };
 }
 
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace pul::network { struct PacketReader; }
+namespace pul::network { struct PacketWriter; }
+
+namespace pul::network {
+
+  enum struct SnapshotEntityType : uint8_t {
+    Player, Projectile, Grenade, Pickup
+  , Size
+  };
+
+  // replicated state of a single entity. The state is flattened into 32-bit
+  // words so it can be delta compressed word by word without the network
+  // library knowing the layout, which belongs to whoever captures it
+  struct SnapshotEntity {
+    static constexpr size_t MaxWords = 32ul; // one bit per word in the mask
+
+    uint32_t networkId = 0u;
+    SnapshotEntityType type = SnapshotEntityType::Size;
+    uint8_t wordCount = 0u;
+    std::array<uint32_t, MaxWords> words = {};
+
+    void Push(uint32_t const word);
+    void Push(float const word);
+
+    uint32_t U32(size_t const wordIdx) const;
+    float F32(size_t const wordIdx) const;
+  };
+
+  // the replicated state of the scene at a given tick
+  struct Snapshot {
+    uint32_t tick = 0u;
+
+    // sorted by networkId
+    std::vector<SnapshotEntity> entities;
+
+    void Sort();
+  };
+
+  // the last few snapshots, indexed by tick. The server delta compresses
+  // against the snapshot a client last acknowledged, the client needs the
+  // same snapshot to decode it
+  struct SnapshotHistory {
+    static constexpr size_t Capacity = 64ul;
+
+    // overwrites whatever snapshot was stored in the slot of tick
+    Snapshot & Store(uint32_t const tick);
+
+    // nullptr if the snapshot was never stored or has been overwritten
+    Snapshot const * Find(uint32_t const tick) const;
+
+    void Clear();
+
+    std::array<Snapshot, Capacity> snapshots;
+    std::array<bool, Capacity> valid { false };
+  };
+
+  // writes only the entities that changed since baseline, and of those only
+  // the words that changed. New entities are compared against zero. Without a
+  // baseline the full snapshot is written
+  void EncodeSnapshotDelta(
+    Snapshot const * baseline
+  , Snapshot const & snapshot
+  , PacketWriter & writer
+  );
+
+  // reads the rest of the packet, returns false if it is malformed
+  bool DecodeSnapshotDelta(
+    Snapshot const * baseline
+  , PacketReader & reader
+  , Snapshot & outSnapshot
+  );
+}
@@ -0,0 +1,535 @@
+#include <pulcher-network/file-transfer.hpp>
+
+#include <pulcher-network/packet.hpp>
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+
+namespace {
+
+// chunks a single request can name, so a malformed request can not make the
+// server read the whole manifest
+constexpr size_t maxChunksPerRequest = 64ul;
+
+size_t ChunkCount(uint64_t const byteLength) {
+  return
+    static_cast<size_t>(
+      (byteLength + pul::network::FileChunkByteLength - 1ul)
+    / pul::network::FileChunkByteLength
+    );
+}
+
+size_t ChunkByteLength(uint64_t const byteLength, size_t const chunkIdx) {
+  uint64_t const offset = chunkIdx * pul::network::FileChunkByteLength;
+  return
+    static_cast<size_t>(
+      std::min<uint64_t>(
+        pul::network::FileChunkByteLength, byteLength - offset
+      )
+    );
+}
+
+// hash of every chunk of the first byteLength bytes of the file, bytes past
+// the end of the file hash as if they were missing
+std::vector<uint64_t> HashFileChunks(
+  std::filesystem::path const & path, uint64_t const byteLength
+) {
+  static std::array<uint8_t, pul::network::FileChunkByteLength> chunk;
+
+  std::vector<uint64_t> hashes;
+  std::ifstream file(path, std::ios::binary);
+
+  for (size_t chunkIdx = 0ul; chunkIdx < ::ChunkCount(byteLength); ++ chunkIdx)
+  {
+    size_t const length = ::ChunkByteLength(byteLength, chunkIdx);
+    file.read(reinterpret_cast<char *>(chunk.data()), length);
+    auto const readLength = std::max<std::streamsize>(file.gcount(), 0);
+    hashes.emplace_back(
+      pul::network::HashChunk(chunk.data(), static_cast<size_t>(readLength))
+    );
+  }
+
+  return hashes;
+}
+
+// a path from the network must stay inside of the root it is written to
+bool SafeRelativePath(std::string const & path) {
+  if (path.empty()) { return false; }
+
+  std::filesystem::path const relative = std::filesystem::path(path);
+  if (relative.has_root_name() || relative.has_root_directory())
+    { return false; }
+
+  for (auto const & component : relative) {
+    if (component == ".." || component == ".") { return false; }
+  }
+
+  return true;
+}
+
+std::filesystem::path PartPath(std::filesystem::path const & path) {
+  std::filesystem::path part = path;
+  part += ".part";
+  return part;
+}
+
+} // -- namespace
+
+uint64_t pul::network::HashChunk(
+  uint8_t const * bytes, size_t const byteLength
+) {
+  // FNV-1a
+  uint64_t hash = 0xCBF29CE484222325ul;
+  for (size_t it = 0ul; it < byteLength; ++ it) {
+    hash ^= bytes[it];
+    hash *= 0x100000001B3ul;
+  }
+  return hash;
+}
+
+pul::network::FileManifest pul::network::FileManifest::Construct(
+  std::filesystem::path const & root
+) {
+  pul::network::FileManifest manifest;
+
+  std::error_code error;
+  for (
+    auto const & entry
+  : std::filesystem::recursive_directory_iterator(root, error)
+  ) {
+    if (!entry.is_regular_file()) { continue; }
+
+    // downloads of a client that serves its own files are not done yet
+    if (entry.path().extension() == ".part") { continue; }
+
+    pul::network::FileManifest::File file;
+    file.path =
+      std::filesystem::relative(entry.path(), root).generic_string();
+    file.byteLength = entry.file_size();
+    file.chunkHashes = ::HashFileChunks(entry.path(), file.byteLength);
+    manifest.files.emplace_back(std::move(file));
+  }
+
+  if (error) {
+    printf(
+      "file transfer - could not read '%s': %s\n"
+    , root.string().c_str(), error.message().c_str()
+    );
+  }
+
+  std::sort(
+    manifest.files.begin(), manifest.files.end()
+  , [](auto const & a, auto const & b) { return a.path < b.path; }
+  );
+
+  return manifest;
+}
+
+void pul::network::WriteManifest(
+  pul::network::PacketWriter & writer
+, pul::network::FileManifest const & manifest
+) {
+  writer.WriteVarint(manifest.files.size());
+  for (auto const & file : manifest.files) {
+    writer.WriteString(file.path);
+    writer.WriteVarint(file.byteLength);
+
+    // the amount of chunks follows from the length
+    writer.WriteBytes(
+      file.chunkHashes.data(), file.chunkHashes.size() * sizeof(uint64_t)
+    );
+  }
+}
+
+bool pul::network::ReadManifest(
+  pul::network::PacketReader & reader
+, pul::network::FileManifest & manifest
+) {
+  uint64_t fileCount;
+  if (!reader.ReadVarint(fileCount)) { return false; }
+
+  manifest.files.clear();
+  for (uint64_t it = 0ul; it < fileCount; ++ it) {
+    pul::network::FileManifest::File file;
+
+    std::string_view path;
+    if (!reader.ReadString(path) || !reader.ReadVarint(file.byteLength))
+      { return false; }
+
+    file.path = std::string(path);
+    if (!::SafeRelativePath(file.path)) {
+      printf("file transfer - refusing path '%s'\n", file.path.c_str());
+      return false;
+    }
+
+    size_t const chunkCount = ::ChunkCount(file.byteLength);
+
+    // every chunk needs a hash, so this also bounds the length
+    if (
+        chunkCount > (reader.byteLength - reader.offset) / sizeof(uint64_t)
+     || file.byteLength > chunkCount * pul::network::FileChunkByteLength
+    ) {
+      return false;
+    }
+
+    file.chunkHashes.resize(chunkCount);
+    if (
+      !reader.ReadBytes(
+        file.chunkHashes.data(), chunkCount * sizeof(uint64_t)
+      )
+    ) {
+      return false;
+    }
+
+    manifest.files.emplace_back(std::move(file));
+  }
+
+  return true;
+}
+
+pul::network::FileTransferServer pul::network::FileTransferServer::Construct(
+  std::filesystem::path const & root
+) {
+  pul::network::FileTransferServer server;
+  server.root = root;
+  server.manifest = pul::network::FileManifest::Construct(root);
+
+  size_t byteLength = 0ul;
+  for (auto const & file : server.manifest.files)
+    { byteLength += file.byteLength; }
+
+  printf(
+    "file transfer - serving %zu files (%zu bytes) from '%s'\n"
+  , server.manifest.files.size(), byteLength, root.string().c_str()
+  );
+
+  return server;
+}
+
+void pul::network::FileTransferServer::SendManifest(
+  pul::network::ServerHost & server, ENetPeer * peer
+) {
+  auto writer =
+    pul::network::PacketWriter::Construct(
+      pul::network::PacketType::FileManifest
+    , pul::network::ChannelType::Reliable
+    , 1024ul
+    );
+  pul::network::WriteManifest(writer, this->manifest);
+  server.Send(writer.Finish(), peer, pul::network::SendPriority::Low);
+}
+
+void pul::network::FileTransferServer::ReceiveChunkRequest(
+  pul::network::Event & event
+) {
+  auto reader = pul::network::PacketReader::Construct(event.packet);
+
+  uint32_t chunkCount;
+  if (!reader.ReadVarint(chunkCount) || chunkCount > ::maxChunksPerRequest) {
+    printf("file transfer - malformed chunk request\n");
+    return;
+  }
+
+  for (uint32_t it = 0u; it < chunkCount; ++ it) {
+    uint32_t fileIdx, chunkIdx;
+    if (!reader.ReadVarint(fileIdx) || !reader.ReadVarint(chunkIdx))
+      { return; }
+
+    if (fileIdx >= this->manifest.files.size()) { continue; }
+    if (chunkIdx >= this->manifest.files[fileIdx].chunkHashes.size())
+      { continue; }
+
+    if (this->queuedChunks.size() >= MaxQueuedChunks) { return; }
+
+    this->queuedChunks.emplace_back(
+      pul::network::FileTransferServer::QueuedChunk {
+        event.peer, fileIdx, chunkIdx
+      }
+    );
+  }
+}
+
+void pul::network::FileTransferServer::Update(
+  pul::network::ServerHost & server
+) {
+  static std::array<uint8_t, pul::network::FileChunkByteLength> chunk;
+
+  for (
+    size_t it = 0ul;
+    it < MaxChunksPerUpdate && !this->queuedChunks.empty();
+    ++ it
+  ) {
+    auto const queued = this->queuedChunks.front();
+    this->queuedChunks.pop_front();
+
+    auto const & file = this->manifest.files[queued.fileIdx];
+    size_t const length = ::ChunkByteLength(file.byteLength, queued.chunkIdx);
+
+    if (queued.fileIdx != this->streamFileIdx) {
+      this->stream = std::ifstream(this->root / file.path, std::ios::binary);
+      this->streamFileIdx = queued.fileIdx;
+    }
+
+    // a failed read leaves the stream in a failed state, clear it so the
+    // next chunk of the file can still be read
+    this->stream.clear();
+    this->stream.seekg(
+      static_cast<std::streamoff>(
+        queued.chunkIdx * pul::network::FileChunkByteLength
+      )
+    );
+    this->stream.read(reinterpret_cast<char *>(chunk.data()), length);
+    if (static_cast<size_t>(this->stream.gcount()) != length) {
+      printf("file transfer - could not read '%s'\n", file.path.c_str());
+      continue;
+    }
+
+    // streamed unreliably, the client requests it again if it is lost
+    auto writer =
+      pul::network::PacketWriter::Construct(
+        pul::network::PacketType::FileChunk
+      , pul::network::ChannelType::Streaming
+      , 16ul + length
+      );
+    writer.WriteVarint(queued.fileIdx);
+    writer.WriteVarint(queued.chunkIdx);
+    writer.WriteVarint(length);
+    writer.WriteBytes(chunk.data(), length);
+    server.Send(writer.Finish(), queued.peer, pul::network::SendPriority::Low);
+  }
+}
+
+void pul::network::FileTransferServer::Disconnect(ENetPeer * peer) {
+  this->queuedChunks.erase(
+    std::remove_if(
+      this->queuedChunks.begin(), this->queuedChunks.end()
+    , [peer](auto const & queued) { return queued.peer == peer; }
+    )
+  , this->queuedChunks.end()
+  );
+}
+
+void pul::network::FileTransferClient::ReceiveManifest(
+  pul::network::Event & event
+) {
+  auto reader = pul::network::PacketReader::Construct(event.packet);
+
+  pul::network::FileManifest remoteManifest;
+  if (
+      !pul::network::ReadManifest(reader, remoteManifest) || !reader.Finished()
+  ) {
+    printf("file transfer - malformed manifest\n");
+    return;
+  }
+
+  this->manifest = std::move(remoteManifest);
+  this->missingChunks.clear();
+  this->requestedChunks.clear();
+  this->remainingChunks.assign(this->manifest.files.size(), 0ul);
+  this->downloadedByteLength = this->totalByteLength = 0ul;
+
+  std::error_code error;
+
+  for (size_t fileIdx = 0ul; fileIdx < this->manifest.files.size(); ++ fileIdx)
+  {
+    auto const & file = this->manifest.files[fileIdx];
+    auto const path = this->root / file.path;
+    auto const partPath = ::PartPath(path);
+
+    bool const hasPart = std::filesystem::exists(partPath, error);
+
+    if (
+        !hasPart && std::filesystem::exists(path, error)
+     && std::filesystem::file_size(path, error) == file.byteLength
+     && ::HashFileChunks(path, file.byteLength) == file.chunkHashes
+    ) {
+      continue;
+    }
+
+    // start out from the previous version, chunks that did not change are
+    // not downloaded again
+    if (!hasPart) {
+      std::filesystem::create_directories(path.parent_path(), error);
+      if (std::filesystem::exists(path, error))
+        { std::filesystem::copy_file(path, partPath, error); }
+      else
+        { std::ofstream{partPath, std::ios::binary}; }
+    }
+
+    std::filesystem::resize_file(partPath, file.byteLength, error);
+    if (error) {
+      printf(
+        "file transfer - could not prepare '%s': %s\n"
+      , partPath.string().c_str(), error.message().c_str()
+      );
+      error.clear();
+      continue;
+    }
+
+    auto const hashes = ::HashFileChunks(partPath, file.byteLength);
+    for (size_t chunkIdx = 0ul; chunkIdx < hashes.size(); ++ chunkIdx) {
+      if (hashes[chunkIdx] == file.chunkHashes[chunkIdx]) { continue; }
+
+      this->missingChunks.emplace_back(
+        Chunk {
+          static_cast<uint32_t>(fileIdx), static_cast<uint32_t>(chunkIdx)
+        }
+      );
+      ++ this->remainingChunks[fileIdx];
+      this->totalByteLength += ::ChunkByteLength(file.byteLength, chunkIdx);
+    }
+
+    // everything arrived before a disconnect, only the rename was missing
+    if (this->remainingChunks[fileIdx] == 0ul) {
+      std::filesystem::rename(partPath, path, error);
+    }
+  }
+
+  printf(
+    "file transfer - %zu chunks (%zu bytes) to download\n"
+  , this->missingChunks.size(), this->totalByteLength
+  );
+}
+
+void pul::network::FileTransferClient::ReceiveChunk(
+  pul::network::Event & event
+) {
+  auto reader = pul::network::PacketReader::Construct(event.packet);
+
+  uint32_t fileIdx, chunkIdx;
+  uint64_t length;
+  std::span<uint8_t const> bytes;
+  if (
+      !reader.ReadVarint(fileIdx) || !reader.ReadVarint(chunkIdx)
+   || !reader.ReadVarint(length) || !reader.ViewBytes(length, bytes)
+  ) {
+    printf("file transfer - malformed chunk\n");
+    return;
+  }
+
+  // only chunks that are still waited on, duplicates are dropped
+  auto requested =
+    std::find_if(
+      this->requestedChunks.begin(), this->requestedChunks.end()
+    , [fileIdx, chunkIdx](auto const & request) {
+        return
+            request.chunk.fileIdx == fileIdx
+         && request.chunk.chunkIdx == chunkIdx
+        ;
+      }
+    );
+  if (requested == this->requestedChunks.end()) { return; }
+  this->requestedChunks.erase(requested);
+
+  auto const & file = this->manifest.files[fileIdx];
+
+  if (
+      pul::network::HashChunk(bytes.data(), bytes.size())
+   != file.chunkHashes[chunkIdx]
+  ) {
+    printf(
+      "file transfer - chunk %u of '%s' is corrupt\n"
+    , chunkIdx, file.path.c_str()
+    );
+    this->missingChunks.emplace_back(Chunk { fileIdx, chunkIdx });
+    return;
+  }
+
+  auto const path = this->root / file.path;
+  auto const partPath = ::PartPath(path);
+
+  {
+    std::fstream stream(
+      partPath, std::ios::binary | std::ios::in | std::ios::out
+    );
+    stream.seekp(
+      static_cast<std::streamoff>(chunkIdx * pul::network::FileChunkByteLength)
+    );
+    stream.write(
+      reinterpret_cast<char const *>(bytes.data())
+    , static_cast<std::streamsize>(bytes.size())
+    );
+
+    if (!stream) {
+      printf(
+        "file transfer - could not write '%s'\n", partPath.string().c_str()
+      );
+      this->missingChunks.emplace_back(Chunk { fileIdx, chunkIdx });
+      return;
+    }
+  }
+
+  this->downloadedByteLength += bytes.size();
+
+  if (-- this->remainingChunks[fileIdx] == 0ul) {
+    std::error_code error;
+    std::filesystem::rename(partPath, path, error);
+    if (error) {
+      printf(
+        "file transfer - could not replace '%s': %s\n"
+      , path.string().c_str(), error.message().c_str()
+      );
+    }
+  }
+
+  if (this->Finished()) {
+    printf(
+      "file transfer - finished, %zu bytes downloaded\n"
+    , this->downloadedByteLength
+    );
+  }
+}
+
+void pul::network::FileTransferClient::Update(
+  pul::network::ClientHost & client
+) {
+  auto const time = std::chrono::steady_clock::now();
+
+  // lost with the streaming channel, or the server never got the request
+  for (auto request = this->requestedChunks.begin();
+       request != this->requestedChunks.end();
+  ) {
+    if (time - request->time < RequestTimeout) { ++ request; continue; }
+
+    this->missingChunks.emplace_front(request->chunk);
+    request = this->requestedChunks.erase(request);
+  }
+
+  while (
+      !this->missingChunks.empty()
+   && this->requestedChunks.size() < MaxChunksInFlight
+  ) {
+    size_t const chunkCount =
+      std::min({
+        ChunksPerRequest
+      , this->missingChunks.size()
+      , MaxChunksInFlight - this->requestedChunks.size()
+      });
+
+    auto writer =
+      pul::network::PacketWriter::Construct(
+        pul::network::PacketType::FileChunkRequest
+      , pul::network::ChannelType::Reliable
+      );
+    writer.WriteVarint(chunkCount);
+
+    for (size_t it = 0ul; it < chunkCount; ++ it) {
+      auto const chunk = this->missingChunks.front();
+      this->missingChunks.pop_front();
+
+      writer.WriteVarint(chunk.fileIdx);
+      writer.WriteVarint(chunk.chunkIdx);
+      this->requestedChunks.emplace_back(RequestedChunk { chunk, time });
+    }
+
+    writer.Finish().Send(client);
+  }
+}
+
+void pul::network::FileTransferClient::Disconnect() {
+  this->missingChunks.clear();
+  this->requestedChunks.clear();
+}
@@ -0,0 +1,421 @@
+#include <pulcher-network/packet.hpp>
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace {
+
+// optional values use all bits set as "none", shifted by one so that it
+// becomes the single byte varint 0
+void WriteOptional(pul::network::PacketWriter & writer, uint32_t const value) {
+  writer.WriteVarint(static_cast<uint32_t>(value + 1u));
+}
+
+bool ReadOptional(pul::network::PacketReader & reader, uint32_t & value) {
+  if (!reader.ReadVarint(value)) { return false; }
+  value -= 1u;
+  return true;
+}
+
+} // -- namespace
+
+pul::network::PacketWriter::PacketWriter() {}
+
+pul::network::PacketWriter::~PacketWriter() {
+  // never finished, so it was never handed to enet either
+  if (this->packet.enetPacket)
+    { enet_packet_destroy(this->packet.enetPacket); }
+  this->packet.enetPacket = nullptr;
+}
+
+pul::network::PacketWriter::PacketWriter(pul::network::PacketWriter && rval) {
+  *this = std::move(rval);
+}
+
+pul::network::PacketWriter & pul::network::PacketWriter::operator=(
+  pul::network::PacketWriter && rval
+) {
+  if (this->packet.enetPacket)
+    { enet_packet_destroy(this->packet.enetPacket); }
+
+  this->packet       = rval.packet;
+  this->buffer       = rval.buffer;
+  this->byteLength   = rval.byteLength;
+  this->byteCapacity = rval.byteCapacity;
+  this->bitsUsed     = rval.bitsUsed;
+
+  rval.packet.enetPacket = nullptr;
+  rval.buffer = nullptr;
+  rval.byteLength = rval.byteCapacity = 0ul;
+  rval.bitsUsed = 0u;
+
+  return *this;
+}
+
+pul::network::PacketWriter pul::network::PacketWriter::Construct(
+  pul::network::PacketType const type
+, pul::network::ChannelType const channel
+, size_t const reserveByteLength
+) {
+  pul::network::PacketWriter writer;
+
+  // enet allocates without copying anything when there is no data
+  writer.byteCapacity = std::max(reserveByteLength, sizeof(type));
+  writer.packet =
+    pul::network::OutgoingPacket::ConstructBytes(
+      nullptr, writer.byteCapacity, channel
+    );
+
+  if (!writer.packet.enetPacket) {
+    printf("network error - failed to create packet\n");
+    writer.byteCapacity = 0ul;
+    return writer;
+  }
+
+  writer.Write(type);
+
+  return writer;
+}
+
+pul::network::PacketWriter pul::network::PacketWriter::ConstructBuffer(
+  std::vector<uint8_t> & bytes
+) {
+  pul::network::PacketWriter writer;
+  bytes.clear();
+  writer.buffer = &bytes;
+  return writer;
+}
+
+uint8_t * pul::network::PacketWriter::Grow(size_t const length) {
+  size_t const offset = this->byteLength;
+  this->byteLength += length;
+
+  if (this->buffer) {
+    this->buffer->resize(this->byteLength);
+    return this->buffer->data() + offset;
+  }
+
+  if (!this->packet.enetPacket) { return nullptr; }
+
+  // grows geometrically so that a packet written byte by byte does not
+  // reallocate every time; enet only moves the data when it has to grow
+  if (this->byteLength > this->byteCapacity) {
+    this->byteCapacity = std::max(this->byteLength, this->byteCapacity*2ul);
+    auto const result =
+      enet_packet_resize(this->packet.enetPacket, this->byteCapacity);
+    if (result != 0) {
+      printf("network error - failed to grow packet\n");
+      enet_packet_destroy(this->packet.enetPacket);
+      this->packet.enetPacket = nullptr;
+      return nullptr;
+    }
+  }
+
+  return this->packet.enetPacket->data + offset;
+}
+
+void pul::network::PacketWriter::WriteBytes(
+  void const * data, size_t const length
+) {
+  this->bitsUsed = 0u;
+  if (length == 0ul) { return; }
+
+  if (uint8_t * bytes = this->Grow(length); bytes)
+    { std::memcpy(bytes, data, length); }
+}
+
+void pul::network::PacketWriter::WriteVarint(uint64_t value) {
+  this->bitsUsed = 0u;
+
+  uint8_t bytes[10];
+  size_t length = 0ul;
+  do {
+    uint8_t byte = value & 0x7Fu;
+    value >>= 7u;
+    if (value != 0u) { byte |= 0x80u; }
+    bytes[length ++] = byte;
+  } while (value != 0u);
+
+  this->WriteBytes(bytes, length);
+}
+
+void pul::network::PacketWriter::WriteVarintSigned(int64_t const value) {
+  this->WriteVarint(
+    (static_cast<uint64_t>(value) << 1u) ^ static_cast<uint64_t>(value >> 63)
+  );
+}
+
+void pul::network::PacketWriter::WriteBits(
+  uint32_t const value, uint32_t const bitCount
+) {
+  for (uint32_t bit = 0u; bit < bitCount; ++ bit) {
+    if (this->bitsUsed == 0u) {
+      uint8_t * byte = this->Grow(1ul);
+      if (!byte) { return; }
+      *byte = 0u;
+    }
+
+    uint8_t * lastByte =
+        (this->buffer ? this->buffer->data() : this->packet.enetPacket->data)
+      + this->byteLength - 1ul
+    ;
+
+    *lastByte |= static_cast<uint8_t>(((value >> bit) & 1u) << this->bitsUsed);
+    this->bitsUsed = (this->bitsUsed + 1u) % 8u;
+  }
+}
+
+void pul::network::PacketWriter::WriteBool(bool const value) {
+  this->WriteBits(value ? 1u : 0u, 1u);
+}
+
+void pul::network::PacketWriter::WriteString(std::string_view const string) {
+  this->WriteVarint(string.size());
+  this->WriteBytes(string.data(), string.size());
+}
+
+pul::network::OutgoingPacket pul::network::PacketWriter::Finish() {
+  pul::network::OutgoingPacket outgoing = this->packet;
+
+  // shrinking only changes the length, the data stays where it is
+  if (outgoing.enetPacket)
+    { enet_packet_resize(outgoing.enetPacket, this->byteLength); }
+
+  this->packet.enetPacket = nullptr;
+  this->byteLength = this->byteCapacity = 0ul;
+  this->bitsUsed = 0u;
+
+  return outgoing;
+}
+
+pul::network::PacketReader pul::network::PacketReader::Construct(
+  pul::network::IncomingPacket const & packet
+) {
+  if (
+      !packet.enetPacket
+   || packet.enetPacket->dataLength < sizeof(pul::network::PacketType)
+  ) {
+    return pul::network::PacketReader{};
+  }
+
+  return
+    pul::network::PacketReader::Construct(
+      packet.enetPacket->data + sizeof(pul::network::PacketType)
+    , packet.enetPacket->dataLength - sizeof(pul::network::PacketType)
+    );
+}
+
+pul::network::PacketReader pul::network::PacketReader::Construct(
+  void const * bytes, size_t const byteLength
+) {
+  pul::network::PacketReader reader;
+  reader.bytes = reinterpret_cast<uint8_t const *>(bytes);
+  reader.byteLength = byteLength;
+  return reader;
+}
+
+bool pul::network::PacketReader::ViewBytes(
+  size_t const length, std::span<uint8_t const> & view
+) {
+  this->bitsUsed = 0u;
+  if (length > this->byteLength - this->offset) { return false; }
+
+  view = std::span<uint8_t const>(this->bytes + this->offset, length);
+  this->offset += length;
+  return true;
+}
+
+bool pul::network::PacketReader::ReadBytes(void * data, size_t const length) {
+  std::span<uint8_t const> view;
+  if (!this->ViewBytes(length, view)) { return false; }
+
+  if (length > 0ul) { std::memcpy(data, view.data(), length); }
+  return true;
+}
+
+bool pul::network::PacketReader::ReadVarint(uint64_t & value) {
+  this->bitsUsed = 0u;
+
+  value = 0u;
+  for (uint32_t shift = 0u; shift < 64u; shift += 7u) {
+    uint8_t byte;
+    if (!this->Read(byte)) { return false; }
+
+    value |= static_cast<uint64_t>(byte & 0x7Fu) << shift;
+    if (!(byte & 0x80u)) { return true; }
+  }
+
+  // more than ten bytes can only be a malformed packet
+  return false;
+}
+
+bool pul::network::PacketReader::ReadVarint(uint32_t & value) {
+  uint64_t wideValue;
+  if (!this->ReadVarint(wideValue) || wideValue > 0xFFFFFFFFu)
+    { return false; }
+
+  value = static_cast<uint32_t>(wideValue);
+  return true;
+}
+
+bool pul::network::PacketReader::ReadVarintSigned(int64_t & value) {
+  uint64_t zigzag;
+  if (!this->ReadVarint(zigzag)) { return false; }
+
+  value =
+    static_cast<int64_t>(zigzag >> 1u) ^ -static_cast<int64_t>(zigzag & 1u);
+  return true;
+}
+
+bool pul::network::PacketReader::ReadBits(
+  uint32_t & value, uint32_t const bitCount
+) {
+  value = 0u;
+  for (uint32_t bit = 0u; bit < bitCount; ++ bit) {
+    if (this->bitsUsed == 0u) {
+      if (this->offset >= this->byteLength) { return false; }
+      ++ this->offset;
+    }
+
+    uint8_t const byte = this->bytes[this->offset - 1ul];
+    value |= static_cast<uint32_t>((byte >> this->bitsUsed) & 1u) << bit;
+    this->bitsUsed = (this->bitsUsed + 1u) % 8u;
+  }
+
+  return true;
+}
+
+bool pul::network::PacketReader::ReadBool(bool & value) {
+  uint32_t bit;
+  if (!this->ReadBits(bit, 1u)) { return false; }
+  value = bit != 0u;
+  return true;
+}
+
+bool pul::network::PacketReader::ReadString(std::string_view & string) {
+  uint64_t length;
+  std::span<uint8_t const> view;
+  if (!this->ReadVarint(length) || !this->ViewBytes(length, view))
+    { return false; }
+
+  string =
+    std::string_view(reinterpret_cast<char const *>(view.data()), view.size());
+  return true;
+}
+
+// -- packets
+
+void pul::network::WritePacket(
+  pul::network::PacketWriter & writer
+, pul::network::PacketSnapshot const & packet
+) {
+  writer.WriteVarint(packet.tick);
+
+  // the baseline is always an older tick, so it is sent as the distance to
+  // it; zero means there is none
+  writer.WriteVarint(
+    packet.baselineTick == pul::network::PacketSnapshot::NoBaseline
+      ? 0u : packet.tick - packet.baselineTick
+  );
+
+  ::WriteOptional(writer, packet.playerNetworkId);
+  ::WriteOptional(writer, packet.inputTick);
+}
+
+bool pul::network::ReadPacket(
+  pul::network::PacketReader & reader
+, pul::network::PacketSnapshot & packet
+) {
+  uint32_t baselineDistance;
+  if (
+      !reader.ReadVarint(packet.tick)
+   || !reader.ReadVarint(baselineDistance)
+   || !::ReadOptional(reader, packet.playerNetworkId)
+   || !::ReadOptional(reader, packet.inputTick)
+  ) {
+    return false;
+  }
+
+  packet.baselineTick =
+    baselineDistance == 0u
+      ? pul::network::PacketSnapshot::NoBaseline
+      : packet.tick - baselineDistance;
+
+  return true;
+}
+
+void pul::network::WritePacket(
+  pul::network::PacketWriter & writer
+, pul::network::PacketSnapshotAck const & packet
+) {
+  writer.WriteVarint(packet.tick);
+}
+
+bool pul::network::ReadPacket(
+  pul::network::PacketReader & reader
+, pul::network::PacketSnapshotAck & packet
+) {
+  return reader.ReadVarint(packet.tick);
+}
+
+void pul::network::WritePacket(
+  pul::network::PacketWriter & writer
+, pul::network::PacketPlayerInput const & packet
+) {
+  using Button = pul::network::PacketPlayerInput::Button;
+
+  writer.WriteVarint(packet.tick);
+  ::WriteOptional(writer, packet.viewTick);
+
+  // movement is -1, 0 or +1 and the direction fits a nibble
+  writer.WriteBits(packet.buttons, static_cast<uint32_t>(Button::Size));
+  writer.WriteBits(static_cast<uint32_t>(packet.movementHorizontal + 1), 2u);
+  writer.WriteBits(static_cast<uint32_t>(packet.movementVertical + 1), 2u);
+  writer.WriteBits(packet.movementDirection, 4u);
+
+  writer.Write(packet.weaponSwitchToType);
+  writer.WriteVarintSigned(packet.weaponSwitch);
+
+  writer.Write(packet.lookDirection);
+  writer.Write(packet.lookOffset);
+  writer.Write(packet.lookAngle);
+}
+
+bool pul::network::ReadPacket(
+  pul::network::PacketReader & reader
+, pul::network::PacketPlayerInput & packet
+) {
+  using Button = pul::network::PacketPlayerInput::Button;
+
+  uint32_t buttons, horizontal, vertical, direction;
+  int64_t weaponSwitch;
+  if (
+      !reader.ReadVarint(packet.tick)
+   || !::ReadOptional(reader, packet.viewTick)
+   || !reader.ReadBits(buttons, static_cast<uint32_t>(Button::Size))
+   || !reader.ReadBits(horizontal, 2u)
+   || !reader.ReadBits(vertical, 2u)
+   || !reader.ReadBits(direction, 4u)
+   || !reader.Read(packet.weaponSwitchToType)
+   || !reader.ReadVarintSigned(weaponSwitch)
+   || !reader.Read(packet.lookDirection)
+   || !reader.Read(packet.lookOffset)
+   || !reader.Read(packet.lookAngle)
+  ) {
+    return false;
+  }
+
+  // 3 would decode to a movement of +2
+  if (horizontal > 2u || vertical > 2u) { return false; }
+
+  packet.buttons = static_cast<uint16_t>(buttons);
+  packet.movementHorizontal = static_cast<int8_t>(horizontal) - int8_t{1};
+  packet.movementVertical = static_cast<int8_t>(vertical) - int8_t{1};
+  packet.movementDirection = static_cast<uint8_t>(direction);
+  packet.weaponSwitch = static_cast<int16_t>(weaponSwitch);
+
+  return true;
+}
@@ -0,0 +1,406 @@
+#include <pulcher-network/shared.hpp>
+
+#include <pulcher-network/queue.hpp>
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+
+// a client with a send budget can build up to this much of it while idle, so
+// that a snapshot after a quiet moment is not held back
+constexpr float sendBudgetBurstSeconds = 0.25f;
+
+struct PendingPacket {
+  ENetPacket * enetPacket = nullptr;
+  ENetPeer * peer = nullptr;
+  pul::network::ChannelType channel = pul::network::ChannelType::Unreliable;
+  pul::network::SendPriority priority = pul::network::SendPriority::Normal;
+};
+
+struct ClientSchedule {
+  // bytes that may still be sent, can go negative by one packet
+  float budget = 0.0f;
+
+  std::array<
+    std::deque<PendingPacket>
+  , static_cast<size_t>(pul::network::SendPriority::Size)
+  > pending;
+};
+
+// a queued packet belongs to the network thread until enet takes it over,
+// which it does not if the send fails
+void DropPacket(PendingPacket const & packet) {
+  if (packet.enetPacket->referenceCount == 0ul)
+    { enet_packet_destroy(packet.enetPacket); }
+}
+
+void SendPacket(PendingPacket const & packet) {
+  auto const result =
+    enet_peer_send(
+      packet.peer, static_cast<uint8_t>(packet.channel), packet.enetPacket
+    );
+
+  if (result < 0) { ::DropPacket(packet); }
+}
+
+pul::network::Event ConstructEvent(ENetEvent const & enetEvent) {
+  pul::network::Event event;
+  event.pollResult = 1ul;
+  event.peer = enetEvent.peer;
+  event.eventType = enetEvent.type;
+  event.packet.enetPacket = enetEvent.packet;
+
+  if (event.eventType == ENET_EVENT_TYPE_RECEIVE) {
+    event.type =
+      *reinterpret_cast<pul::network::PacketType *>(
+        event.packet.enetPacket->data
+      );
+    event.data = event.packet.enetPacket->data;
+  }
+
+  return event;
+}
+
+} // -- namespace
+
+struct pul::network::ServerThread {
+  static constexpr size_t EventCapacity = 4096ul;
+  static constexpr size_t PacketCapacity = 4096ul;
+
+  ENetHost * enetHost = nullptr;
+  size_t clientSendBudget = 0ul;
+
+  std::thread thread;
+  std::atomic<bool> running = false;
+
+  // network thread -> logic thread
+  pul::network::SpscQueue<pul::network::Event, EventCapacity> events;
+
+  // logic thread -> network thread
+  pul::network::SpscQueue<PendingPacket, PacketCapacity> packets;
+
+  // only touched by the logic thread; packets that did not fit into the queue,
+  // retried before anything newer is queued
+  std::deque<PendingPacket> overflowPackets;
+
+  // -- only touched by the network thread
+
+  std::unordered_map<ENetPeer *, ClientSchedule> clients;
+
+  // received while the event queue was full, ENet buffers the rest until the
+  // logic thread catches up
+  pul::network::Event heldEvent;
+  bool holdingEvent = false;
+
+  void Run();
+  void ReceiveEvents(uint32_t const timeoutMs);
+  void SendPackets(float const deltaSeconds);
+  void DropClient(ClientSchedule & client);
+  void Drain();
+
+  // logic thread
+  bool QueueOverflowPackets();
+};
+
+void pul::network::ServerThread::Run() {
+  auto timePrevious = std::chrono::steady_clock::now();
+
+  while (this->running.load(std::memory_order_acquire)) {
+    auto const time = std::chrono::steady_clock::now();
+    float const deltaSeconds =
+      std::chrono::duration<float>(time - timePrevious).count();
+    timePrevious = time;
+
+    this->SendPackets(deltaSeconds);
+
+    // waits for the network for at most a millisecond, which is also the
+    // latency a queued packet has at worst
+    this->ReceiveEvents(1u);
+  }
+}
+
+void pul::network::ServerThread::ReceiveEvents(uint32_t const timeoutMs) {
+  uint32_t timeout = timeoutMs;
+
+  for (;;) {
+    if (this->holdingEvent) {
+      if (!this->events.Push(std::move(this->heldEvent))) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(timeoutMs));
+        return;
+      }
+      this->holdingEvent = false;
+    }
+
+    ENetEvent enetEvent;
+    if (enet_host_service(this->enetHost, &enetEvent, timeout) <= 0)
+      { return; }
+    timeout = 0u;
+
+    // every packet starts with its type, anything shorter is from a peer
+    // that is not speaking the protocol
+    if (
+        enetEvent.type == ENET_EVENT_TYPE_RECEIVE
+     && enetEvent.packet->dataLength < sizeof(pul::network::PacketType)
+    ) {
+      enet_packet_destroy(enetEvent.packet);
+      continue;
+    }
+
+    switch (enetEvent.type) {
+      default: break;
+      case ENET_EVENT_TYPE_CONNECT: {
+        auto & client = this->clients[enetEvent.peer];
+        client.budget =
+          static_cast<float>(this->clientSendBudget) * sendBudgetBurstSeconds;
+      } break;
+      case ENET_EVENT_TYPE_DISCONNECT:
+        if (auto client = this->clients.find(enetEvent.peer);
+            client != this->clients.end()
+        ) {
+          this->DropClient(client->second);
+          this->clients.erase(client);
+        }
+      break;
+    }
+
+    this->heldEvent = ::ConstructEvent(enetEvent);
+    this->holdingEvent = true;
+  }
+}
+
+void pul::network::ServerThread::SendPackets(float const deltaSeconds) {
+  PendingPacket packet;
+  while (this->packets.Pop(packet)) {
+    auto client = this->clients.find(packet.peer);
+    if (client == this->clients.end()) {
+      ::DropPacket(packet);
+      continue;
+    }
+
+    client->second.pending[static_cast<size_t>(packet.priority)]
+      .emplace_back(packet);
+  }
+
+  float const budgetPerSecond = static_cast<float>(this->clientSendBudget);
+
+  for (auto & clientIt : this->clients) {
+    auto & client = clientIt.second;
+
+    if (budgetPerSecond > 0.0f) {
+      client.budget =
+        std::min(
+          client.budget + budgetPerSecond*deltaSeconds
+        , budgetPerSecond*sendBudgetBurstSeconds
+        );
+    }
+
+    for (size_t priority = client.pending.size(); priority-- > 0ul;) {
+      auto & pending = client.pending[priority];
+
+      while (
+          !pending.empty()
+       && (budgetPerSecond == 0.0f || client.budget > 0.0f)
+      ) {
+        client.budget -=
+          static_cast<float>(pending.front().enetPacket->dataLength);
+        ::SendPacket(pending.front());
+        pending.pop_front();
+      }
+
+      // unreliable packets are only worth sending right away
+      for (auto const & unsent : pending) {
+        if (unsent.channel == pul::network::ChannelType::Unreliable)
+          { ::DropPacket(unsent); }
+      }
+
+      pending.erase(
+        std::remove_if(
+          pending.begin(), pending.end()
+        , [](auto const & unsent) {
+            return unsent.channel == pul::network::ChannelType::Unreliable;
+          }
+        )
+      , pending.end()
+      );
+    }
+  }
+
+  enet_host_flush(this->enetHost);
+}
+
+void pul::network::ServerThread::DropClient(ClientSchedule & client) {
+  for (auto & pending : client.pending) {
+    for (auto const & packet : pending)
+      { ::DropPacket(packet); }
+    pending.clear();
+  }
+}
+
+void pul::network::ServerThread::Drain() {
+  pul::network::Event event;
+  while (this->events.Pop(event)) {}
+  this->heldEvent = {};
+  this->holdingEvent = false;
+
+  PendingPacket packet;
+  while (this->packets.Pop(packet))
+    { ::DropPacket(packet); }
+
+  for (auto const & overflow : this->overflowPackets)
+    { ::DropPacket(overflow); }
+  this->overflowPackets.clear();
+
+  for (auto & client : this->clients)
+    { this->DropClient(client.second); }
+}
+
+bool pul::network::ServerThread::QueueOverflowPackets() {
+  while (!this->overflowPackets.empty()) {
+    PendingPacket packet = this->overflowPackets.front();
+    if (!this->packets.Push(std::move(packet))) { return false; }
+    this->overflowPackets.pop_front();
+  }
+
+  return true;
+}
+
+pul::network::ServerHost::ServerHost() {}
+
+pul::network::ServerHost::~ServerHost() {
+  this->StopThread();
+}
+
+pul::network::ServerHost::ServerHost(pul::network::ServerHost && rval) {
+  *this = std::move(rval);
+}
+
+pul::network::ServerHost & pul::network::ServerHost::operator=(
+  pul::network::ServerHost && rval
+) {
+  this->StopThread();
+
+  this->host = std::move(rval.host);
+  this->thread = std::move(rval.thread);
+  this->clientSendBudget = rval.clientSendBudget;
+
+  return *this;
+}
+
+pul::network::ServerHost pul::network::ServerHost::Construct(
+  pul::network::ServerHost::ConstructInfo const & ci
+) {
+  pul::network::ServerHost server;
+
+  auto address = pul::network::Address::Construct(ENET_HOST_ANY, ci.port);
+
+  { // -- construct host
+    pul::network::Host::ConstructInfo constructInfo;
+    constructInfo.address = address;
+    constructInfo.isServer = true;
+    constructInfo.maxConnections = ci.maxConnections;
+    constructInfo.maxChannels =
+      static_cast<size_t>(pul::network::ChannelType::Size);
+    constructInfo.incomingBandwidth = constructInfo.outgoingBandwidth = 0ul;
+    constructInfo.fnConnect = ci.fnConnect;
+    constructInfo.fnDisconnect = ci.fnDisconnect;
+    constructInfo.fnReceive = ci.fnReceive;
+    server.host = pul::network::Host::Construct(constructInfo);
+  }
+
+  server.clientSendBudget = ci.clientSendBudget;
+
+  if (!server.host.Valid()) { return server; }
+
+  return server;
+}
+
+void pul::network::ServerHost::StartThread() {
+  if (this->thread || !this->host.Valid()) { return; }
+
+  this->thread = std::make_unique<pul::network::ServerThread>();
+  this->thread->enetHost = this->host.enetHost;
+  this->thread->clientSendBudget = this->clientSendBudget;
+  this->thread->running.store(true, std::memory_order_release);
+
+  auto * serverThread = this->thread.get();
+  this->thread->thread = std::thread([serverThread]() { serverThread->Run(); });
+}
+
+void pul::network::ServerHost::StopThread() {
+  if (!this->thread) { return; }
+
+  this->thread->running.store(false, std::memory_order_release);
+  this->thread->thread.join();
+  this->thread->Drain();
+  this->thread.reset();
+}
+
+void pul::network::ServerHost::DispatchEvents() {
+  if (!this->thread) {
+    this->host.PollEvents();
+    return;
+  }
+
+  this->thread->QueueOverflowPackets();
+
+  // bounded, so that a flood of events arriving while dispatching can not
+  // keep the logic thread here
+  pul::network::Event event;
+  for (
+    size_t it = 0ul;
+    it < pul::network::ServerThread::EventCapacity
+      && this->thread->events.Pop(event);
+    ++ it
+  ) {
+    switch (event.eventType) {
+      default: break;
+      case ENET_EVENT_TYPE_CONNECT:    this->host.fnConnect(event);    break;
+      case ENET_EVENT_TYPE_DISCONNECT: this->host.fnDisconnect(event); break;
+      case ENET_EVENT_TYPE_RECEIVE:    this->host.fnReceive(event);    break;
+    }
+
+    // releases the received packet now instead of with the next event
+    event = {};
+  }
+}
+
+void pul::network::ServerHost::Send(
+  pul::network::OutgoingPacket const & packet
+, ENetPeer * peer
+, pul::network::SendPriority const priority
+) {
+  if (!packet.enetPacket) {
+    printf("network error - Trying to send nullptr / unconstructed packet\n");
+    return;
+  }
+
+  if (!this->thread) {
+    enet_peer_send(
+      peer, static_cast<uint8_t>(packet.channel), packet.enetPacket
+    );
+    return;
+  }
+
+  PendingPacket pending;
+  pending.enetPacket = packet.enetPacket;
+  pending.peer = peer;
+  pending.channel = packet.channel;
+  pending.priority = priority;
+
+  // the network thread is behind, the packet waits here instead of the
+  // logic thread waiting on it
+  if (
+      !this->thread->QueueOverflowPackets()
+   || !this->thread->packets.Push(std::move(pending))
+  ) {
+    this->thread->overflowPackets.emplace_back(pending);
+  }
+}
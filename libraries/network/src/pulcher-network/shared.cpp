@@ -73,6 +73,12 @@ pul::network::IncomingPacket::IncomingPacket(
 pul::network::IncomingPacket & pul::network::IncomingPacket::operator=(
   pul::network::IncomingPacket && rval
 ) {
+  if (this == &rval) { return *this; }
+
+  // the packet held until now is released, as the destructor would
+  if (this->enetPacket)
+    { enet_packet_destroy(this->enetPacket); }
+
   this->enetPacket = rval.enetPacket;
   rval.enetPacket = nullptr;
   return *this;
@@ -162,6 +168,16 @@ pul::network::Host::ManualPollEvent(size_t timeout) {
 
   event.packet.enetPacket = enetEvent.packet;
 
+  // a packet too short to hold its type is dropped, the event is still
+  // valid so polling carries on
+  if (
+      event.eventType == ENET_EVENT_TYPE_RECEIVE
+   && enetEvent.packet->dataLength < sizeof(pul::network::PacketType)
+  ) {
+    event.packet = {};
+    event.eventType = ENET_EVENT_TYPE_NONE;
+  }
+
   // get type/data if receive packet
   if (event.eventType == ENET_EVENT_TYPE_RECEIVE) {
     event.type =
@@ -209,7 +225,10 @@ pul::network::ClientHostConnection::Construct(
 ) {
   pul::network::ClientHostConnection connection;
   connection.enetPeer =
-    enet_host_connect(host.enetHost, &address.enetAddress, 2, 0);
+    enet_host_connect(
+      host.enetHost, &address.enetAddress
+    , Idx(pul::network::ChannelType::Size), 0
+    );
 
   if (!connection.Valid())
     { printf("network error - could not create client peer connection\n"); }
@@ -256,35 +275,20 @@ pul::network::ClientHost pul::network::ClientHost::Construct(
   return client;
 }
 
-pul::network::ServerHost pul::network::ServerHost::Construct(
-  pul::network::ServerHost::ConstructInfo const & ci
-) {
-  pul::network::ServerHost server;
-
-  auto address = pul::network::Address::Construct(ENET_HOST_ANY, ci.port);
-
-  { // -- construct host
-    pul::network::Host::ConstructInfo constructInfo;
-    constructInfo.address = address;
-    constructInfo.isServer = true;
-    constructInfo.maxConnections = 1ul;
-    constructInfo.maxChannels = Idx(pul::network::ChannelType::Size);
-    constructInfo.incomingBandwidth = constructInfo.outgoingBandwidth = 0ul;
-    constructInfo.fnConnect = ci.fnConnect;
-    constructInfo.fnDisconnect = ci.fnDisconnect;
-    constructInfo.fnReceive = ci.fnReceive;
-    server.host = pul::network::Host::Construct(constructInfo);
-  }
-
-  if (!server.host.Valid()) { return server; }
-
-  return server;
-}
-
 template <typename T>
 pul::network::OutgoingPacket pul::network::OutgoingPacket::Construct(
   T const & data
 , pul::network::ChannelType channelType
+) {
+  return
+    pul::network::OutgoingPacket::ConstructBytes(
+      reinterpret_cast<void const *>(&data), sizeof(T), channelType
+    );
+}
+
+pul::network::OutgoingPacket pul::network::OutgoingPacket::ConstructBytes(
+  void const * data, size_t const byteLength
+, pul::network::ChannelType channelType
 ) {
   pul::network::OutgoingPacket packet;
 
@@ -302,8 +306,7 @@ pul::network::OutgoingPacket pul::network::OutgoingPacket::Construct(
     break;
   }
 
-  packet.enetPacket =
-    enet_packet_create(reinterpret_cast<void const *>(&data), sizeof(T), flag);
+  packet.enetPacket = enet_packet_create(data, byteLength, flag);
   packet.channel = channelType;
 
   return packet;
@@ -322,18 +325,6 @@ pul::network::OutgoingPacket pul::network::OutgoingPacket::Construct(
 , pul::network::ChannelType channelType
 );
 
-template
-pul::network::OutgoingPacket pul::network::OutgoingPacket::Construct(
-  pul::network::PacketFileStreamStart const & data
-, pul::network::ChannelType channelType
-);
-
-template
-pul::network::OutgoingPacket pul::network::OutgoingPacket::Construct(
-  pul::network::PacketFileStreamBlock const & data
-, pul::network::ChannelType channelType
-);
-
 void pul::network::OutgoingPacket::Send(
   pul::network::ClientHost & client
 ) {
@@ -347,6 +338,15 @@ void pul::network::OutgoingPacket::Send(
   );
 }
 
+void pul::network::OutgoingPacket::Send(ENetPeer * peer) {
+  if (!this->enetPacket) {
+    printf("network error - Trying to send nullptr / unconstructed packet\n");
+    return;
+  }
+
+  enet_peer_send(peer, Idx(this->channel), this->enetPacket);
+}
+
 void pul::network::OutgoingPacket::Broadcast(
   pul::network::ServerHost & server
 ) {
@@ -378,8 +378,12 @@ char const * ToString(pul::network::PacketType packetType) {
     default: return "N/A";
     case PT::SystemInfo:          return "SystemInfo";
     case PT::NetworkClientUpdate: return "NetworkClientUpdate";
-    case PT::StreamStart:         return "StreamStart";
-    case PT::StreamBlock:         return "StreamBlock";
+    case PT::FileManifest:        return "FileManifest";
+    case PT::FileChunkRequest:    return "FileChunkRequest";
+    case PT::FileChunk:           return "FileChunk";
+    case PT::Snapshot:            return "Snapshot";
+    case PT::SnapshotAck:         return "SnapshotAck";
+    case PT::PlayerInput:         return "PlayerInput";
   }
 }
 
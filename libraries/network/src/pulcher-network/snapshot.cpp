@@ -0,0 +1,225 @@
+#include <pulcher-network/snapshot.hpp>
+
+#include <pulcher-network/packet.hpp>
+
+#include <algorithm>
+#include <bit>
+
+namespace {
+
+uint32_t ChangedWords(
+  pul::network::SnapshotEntity const * baseline
+, pul::network::SnapshotEntity const & entity
+) {
+  uint32_t mask = 0u;
+  for (size_t wordIdx = 0ul; wordIdx < entity.wordCount; ++ wordIdx) {
+    uint32_t const baselineWord =
+      baseline && wordIdx < baseline->wordCount ? baseline->words[wordIdx] : 0u;
+
+    if (entity.words[wordIdx] != baselineWord)
+      { mask |= 1u << wordIdx; }
+  }
+  return mask;
+}
+
+void WriteEntity(
+  pul::network::PacketWriter & writer
+, pul::network::SnapshotEntity const * baseline
+, pul::network::SnapshotEntity const & entity
+, uint32_t & previousNetworkId
+) {
+  uint32_t const mask = ::ChangedWords(baseline, entity);
+
+  // nothing to tell the client about
+  if (
+      baseline && mask == 0u
+   && baseline->type == entity.type && baseline->wordCount == entity.wordCount
+  ) {
+    return;
+  }
+
+  // IDs are ascending, so the distance to the previous one is written; plus
+  // one as zero ends the list
+  writer.WriteVarint(entity.networkId - previousNetworkId + 1u);
+  previousNetworkId = entity.networkId;
+
+  writer.Write(entity.type);
+  writer.Write(entity.wordCount);
+  writer.WriteVarint(mask);
+
+  for (size_t wordIdx = 0ul; wordIdx < entity.wordCount; ++ wordIdx) {
+    if (mask & (1u << wordIdx))
+      { writer.Write(entity.words[wordIdx]); }
+  }
+}
+
+} // -- namespace
+
+void pul::network::SnapshotEntity::Push(uint32_t const word) {
+  if (wordCount >= MaxWords) { return; }
+  words[wordCount ++] = word;
+}
+
+void pul::network::SnapshotEntity::Push(float const word) {
+  this->Push(std::bit_cast<uint32_t>(word));
+}
+
+uint32_t pul::network::SnapshotEntity::U32(size_t const wordIdx) const {
+  return wordIdx < wordCount ? words[wordIdx] : 0u;
+}
+
+float pul::network::SnapshotEntity::F32(size_t const wordIdx) const {
+  return std::bit_cast<float>(this->U32(wordIdx));
+}
+
+void pul::network::Snapshot::Sort() {
+  std::sort(
+    entities.begin(), entities.end()
+  , [](auto const & a, auto const & b) { return a.networkId < b.networkId; }
+  );
+}
+
+pul::network::Snapshot & pul::network::SnapshotHistory::Store(
+  uint32_t const tick
+) {
+  size_t const slot = tick % Capacity;
+  valid[slot] = true;
+  snapshots[slot].tick = tick;
+  snapshots[slot].entities.clear();
+  return snapshots[slot];
+}
+
+pul::network::Snapshot const * pul::network::SnapshotHistory::Find(
+  uint32_t const tick
+) const {
+  size_t const slot = tick % Capacity;
+  if (!valid[slot] || snapshots[slot].tick != tick) { return nullptr; }
+  return &snapshots[slot];
+}
+
+void pul::network::SnapshotHistory::Clear() {
+  valid.fill(false);
+}
+
+void pul::network::EncodeSnapshotDelta(
+  pul::network::Snapshot const * baseline
+, pul::network::Snapshot const & snapshot
+, pul::network::PacketWriter & writer
+) {
+  // both entity lists are sorted by network ID, so walk them in lockstep to
+  // find the removed, changed and new entities. The changed & new entities
+  // are written as they are found, the removed ones after them
+  std::vector<uint32_t> removed;
+  uint32_t previousNetworkId = 0u;
+
+  auto const baselineBegin =
+    baseline ? baseline->entities.data() : nullptr;
+  auto const baselineEnd =
+    baseline ? baseline->entities.data() + baseline->entities.size() : nullptr;
+
+  auto baselineIt = baselineBegin;
+  for (auto const & entity : snapshot.entities) {
+    while (
+      baselineIt != baselineEnd && baselineIt->networkId < entity.networkId
+    ) {
+      removed.emplace_back(baselineIt->networkId);
+      ++ baselineIt;
+    }
+
+    SnapshotEntity const * baselineEntity = nullptr;
+    if (baselineIt != baselineEnd && baselineIt->networkId == entity.networkId)
+      { baselineEntity = baselineIt; ++ baselineIt; }
+
+    ::WriteEntity(writer, baselineEntity, entity, previousNetworkId);
+  }
+  writer.WriteVarint(0u);
+
+  for (; baselineIt != baselineEnd; ++ baselineIt)
+    { removed.emplace_back(baselineIt->networkId); }
+
+  writer.WriteVarint(removed.size());
+  previousNetworkId = 0u;
+  for (auto const networkId : removed) {
+    writer.WriteVarint(networkId - previousNetworkId);
+    previousNetworkId = networkId;
+  }
+}
+
+bool pul::network::DecodeSnapshotDelta(
+  pul::network::Snapshot const * baseline
+, pul::network::PacketReader & reader
+, pul::network::Snapshot & outSnapshot
+) {
+  outSnapshot.entities.clear();
+  if (baseline)
+    { outSnapshot.entities = baseline->entities; }
+
+  auto const find = [&outSnapshot](uint32_t const networkId) {
+    return
+      std::lower_bound(
+        outSnapshot.entities.begin(), outSnapshot.entities.end(), networkId
+      , [](auto const & entity, uint32_t const id) {
+          return entity.networkId < id;
+        }
+      );
+  };
+
+  uint32_t networkId = 0u;
+  for (;;) {
+    uint32_t networkIdDistance;
+    if (!reader.ReadVarint(networkIdDistance)) { return false; }
+    if (networkIdDistance == 0u) { break; }
+    networkId += networkIdDistance - 1u;
+
+    SnapshotEntity delta;
+    uint32_t mask;
+    if (
+        !reader.Read(delta.type) || !reader.Read(delta.wordCount)
+     || !reader.ReadVarint(mask)
+     || delta.wordCount > SnapshotEntity::MaxWords
+    ) {
+      return false;
+    }
+
+    auto entity = find(networkId);
+    if (
+        entity == outSnapshot.entities.end()
+     || entity->networkId != networkId
+    ) {
+      entity = outSnapshot.entities.insert(entity, SnapshotEntity{});
+      entity->networkId = networkId;
+    }
+
+    entity->type = delta.type;
+    entity->wordCount = delta.wordCount;
+
+    // words past the new count are compared against zero on the next delta
+    for (size_t wordIdx = delta.wordCount; wordIdx < SnapshotEntity::MaxWords;
+         ++ wordIdx)
+      { entity->words[wordIdx] = 0u; }
+
+    for (size_t wordIdx = 0ul; wordIdx < delta.wordCount; ++ wordIdx) {
+      if (!(mask & (1u << wordIdx))) { continue; }
+      if (!reader.Read(entity->words[wordIdx])) { return false; }
+    }
+  }
+
+  uint32_t removedCount;
+  if (!reader.ReadVarint(removedCount)) { return false; }
+
+  networkId = 0u;
+  for (uint32_t it = 0u; it < removedCount; ++ it) {
+    uint32_t networkIdDistance;
+    if (!reader.ReadVarint(networkIdDistance)) { return false; }
+    networkId += networkIdDistance;
+
+    if (
+      auto entity = find(networkId);
+      entity != outSnapshot.entities.end() && entity->networkId == networkId
+    ) {
+      outSnapshot.entities.erase(entity);
+    }
+  }
+
+  return reader.Finished();
+}
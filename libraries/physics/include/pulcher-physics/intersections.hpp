@@ -1,15 +1,15 @@
 #pragma once
 
 #include <pulcher-core/map.hpp>
+#include <pulcher-physics/tileset.hpp>
 
 #include <entt/entt.hpp>
 #include <glm/glm.hpp>
 
 #include <array>
+#include <unordered_map>
 #include <vector>
 
-namespace pul::physics { struct Tileset; }
-
 namespace pul::physics {
 
   enum class IntersectorType : size_t {
@@ -17,6 +17,8 @@ namespace pul::physics {
   , Ray    = 0x20000000
   , Circle = 0x40000000
   , Aabb   = 0x80000000
+  , SweptAabb = 0x100000000
+  , SweptPoint = 0x200000000
   };
 
   struct IntersectorPoint {
@@ -42,6 +44,29 @@ namespace pul::physics {
     glm::vec2 dimensions;
   };
 
+  // aabb moving along its velocity over a single frame
+  struct IntersectorSweptAabb {
+    static IntersectorType constexpr type = IntersectorType::SweptAabb;
+
+    // inputs
+    glm::vec2 origin;
+    glm::vec2 dimensions;
+    glm::vec2 velocity;
+  };
+
+  // point moving along its velocity over a single frame, such as a projectile
+  struct IntersectorSweptPoint {
+    static IntersectorType constexpr type = IntersectorType::SweptPoint;
+
+    // inputs
+    glm::vec2 origin;
+    glm::vec2 velocity;
+
+    // the part of the tick the sweep covers, 0 .. 1, for substeps
+    float tickBegin = 0.0f;
+    float tickEnd = 1.0f;
+  };
+
   struct IntersectorRay {
     static IntersectorType constexpr type = IntersectorType::Ray;
 
@@ -61,12 +86,44 @@ namespace pul::physics {
     size_t imageTileIdx = -1ul, tilesetIdx = -1ul;
   };
 
+  struct SweptIntersectionResults {
+    bool collision = false;
+
+    // fraction of the velocity travelled before contact, 0 .. 1
+    float timeOfImpact = 1.0f;
+
+    // origin of the aabb at the time of impact
+    glm::vec2 origin = glm::vec2(0.0f);
+
+    // normal of the contacted surface, pointing away from the geometry
+    glm::i32vec2 normal = glm::i32vec2(0);
+
+    size_t imageTileIdx = -1ul, tilesetIdx = -1ul;
+  };
+
   struct EntityIntersectionResults {
     bool collision = false;
 
     std::vector<std::pair<glm::i32vec2 /*origin*/, entt::entity>> entities;
   };
 
+  struct EntitySweptIntersectionResults {
+    bool collision = false;
+
+    struct Contact {
+      // fraction of the frame travelled before contact, 0 .. 1
+      float timeOfImpact;
+
+      // origin of the point at the time of impact
+      glm::vec2 origin;
+
+      entt::entity entity;
+    };
+
+    // earliest contact first
+    std::vector<Contact> entities;
+  };
+
   // queries for debug purposes
   struct DebugQueries {
     void Add(
@@ -97,17 +154,49 @@ namespace pul::physics {
   struct TilemapLayer {
     std::vector<pul::physics::Tileset const *> tilesets;
 
-    struct TileInfo {
+    // a tileset tile placed on the layer with a specific orientation, shared
+    // between every placement of it
+    struct OrientedTileInfo {
       size_t imageTileIdx = -1ul;
       size_t tilesetIdx = -1ul;
       pul::core::TileOrientation orientation = pul::core::TileOrientation::None;
-      glm::vec2 origin;
 
-      bool Valid() const { return tilesetIdx != -1ul; }
+      // into distanceFields, -1 if the tile has no distance field
+      size_t distanceFieldIdx = -1ul;
+
+      // of the oriented tile, tiles without one have no collision
+      pul::physics::TileIntersectAccelerationHint accelerationHint =
+        pul::physics::TileIntersectAccelerationHint::Empty;
     };
 
-    std::vector<TileInfo> tileInfo;
-    uint32_t width;
+    // tile of the layer, packed to an index into orientedTiles
+    struct TileInfo {
+      uint32_t orientedTileIdx = -1u;
+
+      bool Valid() const { return orientedTileIdx != -1u; }
+    };
+
+    // square of tiles, only allocated where the layer has geometry
+    struct Chunk {
+      static int32_t constexpr size = 16;
+
+      std::array<TileInfo, size*size> tiles; // [y*size + x]
+    };
+
+    // keyed by chunk coordinate, which can be negative
+    std::unordered_map<uint64_t, Chunk> chunks;
+
+    // bounds of the placed tiles in tile coordinates, [tileMin, tileMax)
+    glm::i32vec2 tileMin = glm::i32vec2(0), tileMax = glm::i32vec2(0);
+
+    // tileset tiles placed on the layer with their orientation applied, one
+    // per tileset tile and orientation. Distance fields are in the same
+    // orientation
+    std::vector<pul::physics::Tile> orientedTiles;
+    std::vector<OrientedTileInfo> orientedTileInfo;
+    std::vector<pul::physics::TileDistanceField> distanceFields;
   };
 
+  static_assert(sizeof(TilemapLayer::TileInfo) == 4ul);
+
 }
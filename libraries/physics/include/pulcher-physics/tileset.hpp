@@ -1,9 +1,10 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
 #include <vector>
 
-// SDF tilesets
+// collision tilesets
 
 namespace pul::physics {
 
@@ -15,10 +16,34 @@ namespace pul::physics {
 
   struct Tile {
     static size_t constexpr gridSize = 32ul;
-    std::array<std::array<float, gridSize>, gridSize> signedDistanceField;
-    std::array<std::array<uint8_t, gridSize>, gridSize> accelerationHints;
+
+    // occupancy packed as bits; bit x of row y is set when texel (x, y) is
+    // solid
+    std::array<uint32_t, gridSize> collisionRows;
+
+    // derived from the rows, so that a tile is only its 128 byte mask; the
+    // collision layer stores the hint of each of its tiles for intersections
+    TileIntersectAccelerationHint AccelerationHint() const;
   };
 
+  static_assert(sizeof(Tile) == 128ul, "a tile is only its collision mask");
+
+  // chebyshev distance, in texels, to the closest texel of opposite
+  // occupancy within the tile; positive for empty texels and negative for
+  // solid texels. Distances are integral so they are stored exactly in a
+  // byte. Only built for tiles placed on the collision layer
+  struct TileDistanceField {
+    // distance used for texels that have no opposite texel in the tile
+    static int8_t constexpr maxDistance = 64;
+
+    // indexed as [x][y]
+    std::array<std::array<int8_t, Tile::gridSize>, Tile::gridSize> distance;
+  };
+
+  static_assert(
+    Tile::gridSize == 32ul, "collision masks pack a tile row in 32 bits"
+  );
+
   struct Tileset {
     std::vector<pul::physics::Tile> tiles;
   };
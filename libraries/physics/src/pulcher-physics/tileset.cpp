@@ -1 +1,14 @@
 #include <pulcher-physics/tileset.hpp>
+
+pul::physics::TileIntersectAccelerationHint
+pul::physics::Tile::AccelerationHint() const {
+  bool empty = true, full = true;
+  for (auto const row : this->collisionRows) {
+    empty = empty && row == 0u;
+    full = full && row == ~0u;
+  }
+
+  if (empty) { return pul::physics::TileIntersectAccelerationHint::Empty; }
+  if (full)  { return pul::physics::TileIntersectAccelerationHint::Full; }
+  return pul::physics::TileIntersectAccelerationHint::Default;
+}
@@ -2,6 +2,7 @@
 
 #include <glm/fwd.hpp>
 
+#include <cstdint>
 #include <span>
 #include <string>
 #include <vector>
@@ -9,6 +10,8 @@
 
 namespace pul::core { struct RenderBundleInstance; }
 namespace pul::core { struct SceneBundle; }
+namespace pul::network { struct PacketPlayerInput; }
+namespace pul::network { struct Snapshot; }
 namespace pul::plugin { struct Info; }
 
 namespace pul::plugin {
@@ -34,6 +37,34 @@ namespace pul::plugin {
 
     void (*LogicUpdate)(pul::core::SceneBundle & scene);
 
+    void (*CaptureSnapshot)(
+      pul::core::SceneBundle const & scene
+    , pul::network::Snapshot & snapshot
+    );
+
+    void (*ApplySnapshot)(
+      pul::core::SceneBundle & scene
+    , pul::network::Snapshot const & snapshot
+    , uint32_t const localNetworkId
+    , uint32_t const inputTick
+    );
+
+    void (*CapturePlayerInput)(
+      pul::core::SceneBundle const & scene
+    , pul::network::PacketPlayerInput & input
+    );
+
+    void (*ApplyNetworkPlayerInput)(
+      pul::core::SceneBundle & scene
+    , uint32_t const networkId
+    , pul::network::PacketPlayerInput const * input
+    );
+
+    uint32_t (*ConstructNetworkPlayer)(pul::core::SceneBundle & scene);
+    void (*DestroyNetworkPlayer)(
+      pul::core::SceneBundle & scene, uint32_t const networkId
+    );
+
     void (*Initialize)(pul::core::SceneBundle & scene);
     void (*LoadMap)(pul::core::SceneBundle & scene, char const * mapPath);
 
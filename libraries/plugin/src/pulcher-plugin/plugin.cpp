@@ -134,6 +134,16 @@ void LoadPluginFunctions(pul::plugin::Info & plugin, Plugin & ctx) {
   ctx.LoadFunction(
     plugin.UpdateRenderBundleInstance, "Plugin_UpdateRenderBundleInstance"
   );
+  ctx.LoadFunction(
+    plugin.ApplyNetworkPlayerInput, "Plugin_ApplyNetworkPlayerInput"
+  );
+  ctx.LoadFunction(plugin.ApplySnapshot, "Plugin_ApplySnapshot");
+  ctx.LoadFunction(plugin.CapturePlayerInput, "Plugin_CapturePlayerInput");
+  ctx.LoadFunction(plugin.CaptureSnapshot, "Plugin_CaptureSnapshot");
+  ctx.LoadFunction(
+    plugin.ConstructNetworkPlayer, "Plugin_ConstructNetworkPlayer"
+  );
+  ctx.LoadFunction(plugin.DestroyNetworkPlayer, "Plugin_DestroyNetworkPlayer");
   ctx.LoadFunction(plugin.DebugUiDispatch, "Plugin_DebugUiDispatch");
   ctx.LoadFunction(plugin.Initialize, "Plugin_Initialize");
   ctx.LoadFunction(plugin.Interpolate, "Plugin_Interpolate");
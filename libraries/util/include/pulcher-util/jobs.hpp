@@ -0,0 +1,32 @@
+#pragma once
+
+#include <pulcher-util/pimpl.hpp>
+
+#include <cstddef>
+#include <functional>
+
+namespace pul::util {
+  // pool of worker threads to split the data-parallel work of a logic tick
+  // across cores. Every worker owns a queue of jobs and steals from the queues
+  // of the other workers once its own runs dry
+  struct JobPool {
+    // defaults to one worker less than there are cores, as the thread that
+    // submits the work also processes it
+    JobPool();
+    explicit JobPool(size_t workerCount);
+    ~JobPool();
+
+    // calls fn(begin, end) for chunks of [0, count) of at most chunkSize
+    // elements, returns once every chunk has been processed. Chunks run
+    // concurrently, so fn must only touch the elements of its own chunk
+    void ParallelFor(
+      size_t const count, size_t const chunkSize
+    , std::function<void(size_t begin, size_t end)> const & fn
+    );
+
+    size_t WorkerCount() const;
+
+    struct Impl;
+    pul::util::pimpl<Impl> impl;
+  };
+}
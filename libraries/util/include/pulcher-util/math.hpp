@@ -14,57 +14,123 @@ namespace pul::util {
     texelOrigin = glm::u32vec2(origin.x%32ul, origin.y%32ul);
     return true;
   }
+
+  // integer division rounding towards negative infinity
+  inline int64_t FloorDiv(int64_t const numerator, int64_t const denominator) {
+    int64_t quotient = numerator / denominator;
+    if (
+        (numerator % denominator != 0)
+     && ((numerator < 0) != (denominator < 0))
+    ) {
+      -- quotient;
+    }
+    return quotient;
+  }
 }
 
 namespace pul::physics {
-  template <typename Fn>
-  void BresenhamLine(glm::ivec2 f0, glm::ivec2 f1, Fn && fn) {
-    bool steep = false;
-    if (glm::abs(f0.x-f1.x) < glm::abs(f0.y-f1.y)) {
-      std::swap(f0.x, f0.y);
-      std::swap(f1.x, f1.y);
-      steep = true;
+  // rasterized line, every step moves the major axis by one pixel and the
+  // pixel of a step is `begin + round(delta * step / length)`; so consecutive
+  // pixels are at most one texel apart on either axis
+  struct PixelLine {
+    glm::i32vec2 begin;
+    glm::i32vec2 delta;
+    int32_t length; // last step of the line, inclusive
+
+    static PixelLine Construct(
+      glm::i32vec2 const & beginOrigin, glm::i32vec2 const & endOrigin
+    ) {
+      PixelLine self;
+      self.begin = beginOrigin;
+      self.delta = endOrigin - beginOrigin;
+      self.length = glm::max(glm::abs(self.delta.x), glm::abs(self.delta.y));
+      return self;
     }
 
+    glm::i32vec2 Pixel(int32_t const step) const {
+      if (length == 0) { return begin; }
 
-    uint32_t maxSteps = 1'000u;
-    if (f0.x > f1.x) {
-      int32_t
-        dx = f0.x-f1.x
-      , dy = f1.y-f0.y
-      , derror = glm::abs(dy)*2
-      , error = 0.0f
-      , stepy = f1.y > f0.y ? +1.0f : -1.0f
+      int64_t const
+        numeratorX = int64_t{2}*step*delta.x + length
+      , numeratorY = int64_t{2}*step*delta.y + length
       ;
 
-      for (glm::ivec2 f = f0; f.x >= f1.x; -- f.x) {
-        if (--maxSteps == 0u) { break; }
-        if (steep) { fn(f.y, f.x); } else { fn(f.x, f.y); }
-        error += derror;
-        if (error > dx) {
-          f.y += stepy;
-          error -= dx*2;
-        }
-      }
-    } else {
-      int32_t
-        dx = f1.x-f0.x
-      , dy = f1.y-f0.y
-      , derror = glm::abs(dy)*2
-      , error = 0.0f
-      , stepy = f1.y > f0.y ? +1.0f : -1.0f
+      return
+        begin
+      + glm::i32vec2(
+          pul::util::FloorDiv(numeratorX, int64_t{2}*length)
+        , pul::util::FloorDiv(numeratorY, int64_t{2}*length)
+        );
+    }
+
+    // first step whose pixel has passed beyond the inclusive [min, max]
+    // range on the given axis, in the direction the line travels; or
+    // length+1 if the line never leaves it
+    int32_t AxisExitStep(
+      size_t const axis, int32_t const min, int32_t const max
+    ) const {
+      int64_t const
+        axisDelta = delta[axis]
+      , doubleLength = int64_t{2}*length
       ;
 
-      for (glm::ivec2 f = f0; f.x <= f1.x; ++ f.x) {
-        if (--maxSteps == 0u) { break; }
-        if (steep) { fn(f.y, f.x); } else { fn(f.x, f.y); }
-        error += derror;
-        if (error > dx) {
-          f.y += stepy;
-          error -= dx*2;
-        }
+      int64_t exitStep = int64_t{length} + 1;
+
+      if (axisDelta > 0) {
+        // pixel - begin >= offset <=> 2*s*delta + length >= 2*length*offset
+        int64_t const offset = int64_t{max} + 1 - begin[axis];
+        exitStep =
+          -pul::util::FloorDiv(length - doubleLength*offset, 2*axisDelta);
+      } else if (axisDelta < 0) {
+        // pixel - begin <= offset <=> 2*s*delta + length < 2*length*(offset+1)
+        int64_t const offset = int64_t{min} - 1 - begin[axis];
+        exitStep =
+            pul::util::FloorDiv(length - doubleLength*(offset+1), -2*axisDelta)
+          + 1
+        ;
       }
+
+      return static_cast<int32_t>(glm::min(exitStep, int64_t{length} + 1));
     }
+  };
 
+  // amanatides-woo traversal of the grid of `cellSize` pixel cells that the
+  // pixel line passes through, in order. Calls
+  // `fn(cell, stepBegin, stepEnd) -> bool` with the exclusive step range the
+  // line spends inside of the cell; traversal stops once fn returns true
+  template <typename Fn>
+  void TraverseGridLine(
+    PixelLine const & line, int32_t const cellSize, Fn && fn
+  ) {
+    glm::i32vec2 cell =
+      glm::i32vec2(
+        pul::util::FloorDiv(line.begin.x, cellSize)
+      , pul::util::FloorDiv(line.begin.y, cellSize)
+      );
+
+    glm::i32vec2 const cellStep = glm::sign(line.delta);
+
+    auto const axisExit = [&](size_t const axis) {
+      return
+        line.AxisExitStep(
+          axis, cell[axis]*cellSize, cell[axis]*cellSize + cellSize - 1
+        );
+    };
+
+    // step at which the line crosses into the next cell on each axis
+    int32_t exitX = axisExit(0ul), exitY = axisExit(1ul);
+
+    for (int32_t stepBegin = 0; stepBegin <= line.length;) {
+      int32_t const stepEnd = glm::min(exitX, exitY);
+
+      if (fn(cell, stepBegin, stepEnd)) { return; }
+
+      // a corner crossing moves along both axes at once
+      bool const crossX = exitX == stepEnd, crossY = exitY == stepEnd;
+      if (crossX) { cell.x += cellStep.x; exitX = axisExit(0ul); }
+      if (crossY) { cell.y += cellStep.y; exitY = axisExit(1ul); }
+
+      stepBegin = stepEnd;
+    }
   }
 }
@@ -0,0 +1,173 @@
+#include <pulcher-util/jobs.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Batch {
+  std::function<void(size_t, size_t)> const * fn;
+  std::atomic<size_t> remainingChunks;
+};
+
+struct Job {
+  Batch * batch;
+  size_t begin, end;
+};
+
+struct JobQueue {
+  std::mutex mutex;
+  std::deque<Job> jobs;
+};
+
+} // -- namespace
+
+struct pul::util::JobPool::Impl {
+  // one queue per worker, the last one belongs to the submitting thread
+  std::vector<std::unique_ptr<::JobQueue>> queues;
+  std::vector<std::thread> workers;
+
+  std::atomic<size_t> queuedJobs = 0ul;
+
+  std::mutex sleepMutex;
+  std::condition_variable sleepCondition;
+  bool shutdown = false;
+
+  explicit Impl(size_t const workerCount = 0ul) {
+    for (size_t queueIdx = 0ul; queueIdx < workerCount + 1ul; ++ queueIdx)
+      { queues.emplace_back(std::make_unique<::JobQueue>()); }
+
+    for (size_t workerIdx = 0ul; workerIdx < workerCount; ++ workerIdx) {
+      workers.emplace_back([this, workerIdx]() { this->WorkerLoop(workerIdx); });
+    }
+  }
+
+  ~Impl() {
+    {
+      std::lock_guard<std::mutex> lock(sleepMutex);
+      shutdown = true;
+    }
+    sleepCondition.notify_all();
+
+    for (auto & worker : workers) { worker.join(); }
+  }
+
+  // takes the oldest job of its own queue, otherwise steals the newest job of
+  // another queue
+  bool PopJob(size_t const queueIdx, ::Job & job) {
+    for (size_t it = 0ul; it < queues.size(); ++ it) {
+      auto & queue = *queues[(queueIdx + it) % queues.size()];
+
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      if (queue.jobs.empty()) { continue; }
+
+      if (it == 0ul) {
+        job = queue.jobs.front();
+        queue.jobs.pop_front();
+      } else {
+        job = queue.jobs.back();
+        queue.jobs.pop_back();
+      }
+
+      queuedJobs.fetch_sub(1ul);
+      return true;
+    }
+
+    return false;
+  }
+
+  void RunJob(::Job const & job) {
+    (*job.batch->fn)(job.begin, job.end);
+    job.batch->remainingChunks.fetch_sub(1ul, std::memory_order_release);
+  }
+
+  void WorkerLoop(size_t const workerIdx) {
+    for (;;) {
+      ::Job job;
+      if (this->PopJob(workerIdx, job)) {
+        this->RunJob(job);
+        continue;
+      }
+
+      std::unique_lock<std::mutex> lock(sleepMutex);
+      sleepCondition.wait(
+        lock, [this]() { return shutdown || queuedJobs.load() > 0ul; }
+      );
+
+      if (shutdown) { return; }
+    }
+  }
+};
+
+#define PIMPL_SPECIALIZE pul::util::JobPool::Impl
+#include <pulcher-util/pimpl.inl>
+
+pul::util::JobPool::JobPool()
+  : JobPool(std::max(std::thread::hardware_concurrency(), 1u) - 1u)
+{}
+
+pul::util::JobPool::JobPool(size_t const workerCount)
+  : impl(workerCount)
+{}
+
+pul::util::JobPool::~JobPool() = default;
+
+void pul::util::JobPool::ParallelFor(
+  size_t const count, size_t const chunkSize
+, std::function<void(size_t begin, size_t end)> const & fn
+) {
+  if (count == 0ul) { return; }
+
+  size_t const chunkLength = std::max(chunkSize, size_t{1});
+  size_t const chunks = (count + chunkLength - 1ul) / chunkLength;
+
+  // not worth waking anyone up
+  if (impl->workers.empty() || chunks == 1ul) {
+    for (size_t begin = 0ul; begin < count; begin += chunkLength)
+      { fn(begin, std::min(begin + chunkLength, count)); }
+    return;
+  }
+
+  ::Batch batch;
+  batch.fn = &fn;
+  batch.remainingChunks = chunks;
+
+  // deal chunks round-robin, so every worker starts off with its own work
+  for (size_t chunkIdx = 0ul; chunkIdx < chunks; ++ chunkIdx) {
+    auto & queue = *impl->queues[chunkIdx % impl->queues.size()];
+    size_t const begin = chunkIdx*chunkLength;
+
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.jobs.emplace_back(
+      ::Job { &batch, begin, std::min(begin + chunkLength, count) }
+    );
+  }
+
+  impl->queuedJobs.fetch_add(chunks);
+
+  // workers check for jobs while holding the sleep mutex, so acquiring it
+  // once guarantees the notify can not slip in before they wait
+  { std::lock_guard<std::mutex> lock(impl->sleepMutex); }
+  impl->sleepCondition.notify_all();
+
+  // help out until the entire batch has been processed
+  size_t const submitQueueIdx = impl->queues.size() - 1ul;
+  while (batch.remainingChunks.load(std::memory_order_acquire) > 0ul) {
+    ::Job job;
+    if (impl->PopJob(submitQueueIdx, job)) {
+      impl->RunJob(job);
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+
+size_t pul::util::JobPool::WorkerCount() const {
+  return impl->workers.size();
+}
@@ -15,9 +15,13 @@ namespace plugin::animation {
   , float const skeletalRotation
   );
 
+  // msElapsed advances the animation states, leave at zero to only refresh
+  // the vertices. Only pieces whose matrix, frame or wrapping changed are
+  // refreshed, unless forceUpdate is set
   void ComputeVertices(
     pul::animation::Instance & instance
   , bool forceUpdate = false
+  , float const msElapsed = 0.0f
   );
 
   void LoadAnimations(
@@ -2,35 +2,50 @@
 
 #include <pulcher-animation/animation.hpp>
 
+#include <cstdint>
 #include <vector>
-#include <unordered_map>
 
 namespace pul::animation { struct Instance; }
 namespace pul::core { struct RenderBundleInstance; }
 namespace pul::core { struct SceneBundle; }
+namespace pul::gfx { struct Spritesheet; }
 
 namespace plugin::animation {
 
-  struct Interpolant {
-    pul::animation::Instance instance;
-  };
-}
+  // what rendering needs of the visible animation instances of a logic tick,
+  // laid out per field. Capturing & interpolating it only copies vertex data,
+  // and snapshots are reused so that their buffers stay allocated
+  struct RenderSnapshot {
+    // -- per instance, in increasing order of id
+    std::vector<size_t> ids;
+    std::vector<glm::vec2> origins;
+    std::vector<pul::gfx::Spritesheet const *> spritesheets;
+    std::vector<uint32_t> vertexOffsets;
+    std::vector<uint32_t> vertexCounts;
 
-template <typename... T>
-using InterpolantMap = std::unordered_map<size_t, T...>;
+    // -- per vertex, origins are relative to the origin of their instance
+    std::vector<glm::vec3> vertexOrigins;
+    std::vector<glm::vec2> vertexUvCoords;
 
-namespace plugin::animation {
+    size_t Size() const { return ids.size(); }
+
+    void Clear();
+
+    // has to be called in increasing order of id, skips instances that have
+    // no vertices computed yet
+    void Add(size_t const id, pul::animation::Instance const & instance);
+  };
 
   void RenderInterpolated(
     pul::core::SceneBundle const & scene
   , pul::core::RenderBundleInstance const & interpolatedBundle
-  , std::vector<plugin::animation::Interpolant> const & instancesCurrent
+  , plugin::animation::RenderSnapshot const & snapshot
   );
 
   void Interpolate(
     const float msDeltaInterp
-  , InterpolantMap<plugin::animation::Interpolant> const & instancesPrevious
-  , InterpolantMap<plugin::animation::Interpolant> const & instancesCurrent
-  , std::vector<plugin::animation::Interpolant> & instancesOutput
+  , plugin::animation::RenderSnapshot const & previous
+  , plugin::animation::RenderSnapshot const & current
+  , plugin::animation::RenderSnapshot & output
   );
 }
@@ -14,7 +14,7 @@ namespace plugin::bot {
   void BuildNavigationMap(
     std::vector<pul::physics::Tileset const *> const & tilesets
   , std::vector<std::span<size_t>>             const & mapTileIndices
-  , std::vector<std::span<glm::u32vec2>>       const & mapTileOrigins
+  , std::vector<std::span<glm::i32vec2>>       const & mapTileOrigins
   , std::vector<
       std::span<pul::core::TileOrientation>
     > const & mapTileOrientations
@@ -26,6 +26,18 @@ namespace plugin::entity {
   , pul::core::ComponentDamageable & damageable
   );
 
+  // only the input driven movement & collision of UpdatePlayer; no animation,
+  // audio, weapons, pickups or damage. Used to replay inputs the server has
+  // not acknowledged yet on top of its corrected state
+  void PredictPlayerMovement(
+    pul::core::SceneBundle & scene
+  , pul::controls::Controller const & controller
+  , pul::core::ComponentPlayer & player
+  , glm::vec2 & playerOrigin
+  , pul::core::ComponentHitboxAABB & hitboxAabb
+  , pul::animation::ComponentInstance const & playerAnimation
+  );
+
   void DebugUiDispatchPlayer(
     pul::core::SceneBundle & scene
   , pul::core::ComponentPlayer & player
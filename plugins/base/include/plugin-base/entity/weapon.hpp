@@ -266,11 +266,26 @@ namespace plugin::entity {
     glm::vec2 origin = {};
   };
 
+  // rewindMs tests against the hitboxes as they were that long ago, so that a
+  // hitscan hits what the shooter saw on their screen
   WeaponDamageRaycastReturnInfo WeaponDamageRaycast(
     pul::core::SceneBundle & scene
   , glm::vec2 const & originBegin, glm::vec2 const & originEnd
   , float const damage, float const force
   , entt::entity playerEntity
+  , float const rewindMs = 0.0f
+  );
+
+  // projectile moving along its velocity over the frame, swept against the
+  // motion of players so neither can tunnel through the other. The origin is
+  // where the projectile made contact. A substep covers only part of the
+  // tick, from tickBegin to tickEnd
+  WeaponDamageRaycastReturnInfo WeaponDamageSweep(
+    pul::core::SceneBundle & scene
+  , glm::vec2 const & origin, glm::vec2 const & velocity
+  , float const damage, float const force
+  , entt::entity playerEntity
+  , float const tickBegin = 0.0f, float const tickEnd = 1.0f
   );
 
   // ignoreEntity - can be null, describes which entity to be ignored
@@ -279,5 +294,6 @@ namespace plugin::entity {
   , glm::vec2 const & origin, float const radius
   , float const damage, float const force
   , entt::entity const ignoredEntity
+  , float const rewindMs = 0.0f
   );
 }
@@ -8,7 +8,7 @@ namespace plugin::map {
     pul::core::SceneBundle & scene
   , char const * filename
   );
-  void Shutdown();
+  void Shutdown(pul::core::SceneBundle & scene);
   void DebugUiDispatch(pul::core::SceneBundle & scene);
   void Render(
     pul::core::SceneBundle const & scene
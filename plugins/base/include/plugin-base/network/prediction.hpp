@@ -0,0 +1,47 @@
+#pragma once
+
+#include <glm/fwd.hpp>
+
+#include <cstdint>
+
+namespace pul::controls { struct Controller; }
+namespace pul::core { struct ComponentPlayer; }
+namespace pul::core { struct SceneBundle; }
+namespace pul::network { struct PacketPlayerInput; }
+namespace pul::network { struct SnapshotEntity; }
+
+namespace plugin::network {
+  // remembers the input the local player ran this tick and the state it
+  // predicted from it
+  void RecordPrediction(
+    pul::core::SceneBundle const & scene
+  , pul::controls::Controller const & controller
+  , pul::core::ComponentPlayer const & player
+  , glm::vec2 const & origin
+  );
+
+  // compares the server's state of the local player after inputTick against
+  // the prediction of that tick. On a misprediction the local player is reset
+  // to the server's state and every input after inputTick is replayed
+  void ReconcilePrediction(
+    pul::core::SceneBundle & scene
+  , pul::network::SnapshotEntity const & serverState
+  , uint32_t const inputTick
+  );
+
+  // the local player's input of the current tick, to send to the server
+  void CapturePlayerInput(
+    pul::core::SceneBundle const & scene
+  , pul::network::PacketPlayerInput & input
+  );
+
+  // the input a network player runs on the next tick, nullptr holds on to the
+  // previous input (without triggering jumps, dashes etc. again)
+  void ApplyNetworkPlayerInput(
+    pul::core::SceneBundle & scene
+  , uint32_t const networkId
+  , pul::network::PacketPlayerInput const * input
+  );
+
+  void ClearPredictions();
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <glm/fwd.hpp>
+
+#include <cstdint>
+
+namespace pul::core { struct ComponentDamageable; }
+namespace pul::core { struct ComponentPlayer; }
+namespace pul::core { struct SceneBundle; }
+namespace pul::network { struct Snapshot; }
+namespace pul::network { struct SnapshotEntity; }
+
+namespace plugin::network {
+  // flattens the replicated components of the scene (players, projectiles,
+  // grenades & pickups) into a snapshot, the network ID is the entity ID
+  void CaptureSnapshot(
+    pul::core::SceneBundle const & scene
+  , pul::network::Snapshot & snapshot
+  );
+
+  // applies a snapshot received from the server. Remote players are spawned as
+  // replicas that only follow the snapshots, pickups are matched to the map's
+  // pickups by origin. The local player is the one with localNetworkId, it is
+  // reconciled with its prediction of inputTick instead
+  void ApplySnapshot(
+    pul::core::SceneBundle & scene
+  , pul::network::Snapshot const & snapshot
+  , uint32_t const localNetworkId
+  , uint32_t const inputTick
+  );
+
+  // writes the replicated state of a captured player onto a player
+  void ReadPlayerState(
+    pul::network::SnapshotEntity const & entity
+  , pul::core::ComponentPlayer & player
+  , glm::vec2 & origin
+  , pul::core::ComponentDamageable & damageable
+  );
+
+  // spawns a player that is controlled by a client's inputs, returns its
+  // network ID
+  uint32_t ConstructNetworkPlayer(pul::core::SceneBundle & scene);
+
+  void DestroyNetworkPlayer(
+    pul::core::SceneBundle & scene, uint32_t const networkId
+  );
+
+  // forgets every replica, their entities are owned by the registry
+  void Shutdown();
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <entt/entt.hpp>
+
 #include <span>
 #include <vector>
 
@@ -7,15 +9,28 @@ namespace pul::core { enum class TileOrientation : size_t; }
 namespace pul::core { struct SceneBundle; }
 namespace pul::gfx { struct Image; }
 namespace pul::physics { struct EntityIntersectionResults; }
+namespace pul::physics { struct EntitySweptIntersectionResults; }
 namespace pul::physics { struct IntersectionResults; }
 namespace pul::physics { struct IntersectorAabb; }
 namespace pul::physics { struct IntersectorCircle; }
 namespace pul::physics { struct IntersectorPoint; }
 namespace pul::physics { struct IntersectorRay; }
+namespace pul::physics { struct IntersectorSweptAabb; }
+namespace pul::physics { struct IntersectorSweptPoint; }
+namespace pul::physics { struct SweptIntersectionResults; }
 namespace pul::physics { struct TilemapLayer; }
 namespace pul::physics { struct Tileset; }
 
 namespace plugin::physics {
+  // rebuilds the spatial hash that entity queries gather their candidates
+  // from, once per logic tick. Entities moving during the tick should update
+  // their cells, entities created during the tick are not queried until the
+  // next rebuild
+  void RebuildEntityBroadphase(pul::core::SceneBundle & scene);
+  void UpdateEntityBroadphase(
+    pul::core::SceneBundle & scene, entt::entity entity
+  );
+
   void EntityIntersectionRaycast(
     pul::core::SceneBundle & scene
   , pul::physics::IntersectorRay const & ray
@@ -28,6 +43,40 @@ namespace plugin::physics {
   , pul::physics::EntityIntersectionResults & intersectionResults
   );
 
+  // hitboxes older than this are not kept around for rewound queries
+  constexpr float MaxRewindMs = 250.0f;
+
+  // stores where every hitbox is at the end of the current tick
+  void RecordHitboxHistory(pul::core::SceneBundle & scene);
+  void ClearHitboxHistory();
+
+  // the same queries against the hitboxes as they were rewindMs ago,
+  // interpolated between the recorded ticks. Rewinds are clamped to
+  // MaxRewindMs, without history that far back the present hitboxes are used
+  void EntityIntersectionRaycastRewound(
+    pul::core::SceneBundle & scene
+  , pul::physics::IntersectorRay const & ray
+  , float const rewindMs
+  , pul::physics::EntityIntersectionResults & intersectionResults
+  );
+
+  void EntityIntersectionCircleRewound(
+    pul::core::SceneBundle & scene
+  , pul::physics::IntersectorCircle const & circle
+  , float const rewindMs
+  , pul::physics::EntityIntersectionResults & intersectionResults
+  );
+
+  // continuous test of a point moving over the frame against the hitboxes of
+  // entities. Players move from their current origin along their velocity
+  // over the same frame, every other entity is static; so a fast point and a
+  // fast player can not tunnel through each other
+  void EntityIntersectionSweptPoint(
+    pul::core::SceneBundle & scene
+  , pul::physics::IntersectorSweptPoint const & sweep
+  , pul::physics::EntitySweptIntersectionResults & intersectionResults
+  );
+
   void ProcessTileset(
     pul::physics::Tileset & tileset
   , pul::gfx::Image const & image
@@ -38,7 +87,7 @@ namespace plugin::physics {
   void LoadMapGeometry(
     std::vector<pul::physics::Tileset const *> const & tilesets
   , std::vector<std::span<size_t>>             const & mapTileIndices
-  , std::vector<std::span<glm::u32vec2>>       const & mapTileOrigins
+  , std::vector<std::span<glm::i32vec2>>       const & mapTileOrigins
   , std::vector<std::span<pul::core::TileOrientation>> const & mapTileOrientations
   );
 
@@ -54,6 +103,15 @@ namespace plugin::physics {
   , pul::physics::IntersectionResults & intersectionResults
   );
 
+  // traces a batch of rays, the results of a ray are written to the same
+  // index. Rays are traced in order of the tile they begin in, so that rays
+  // close to each other reuse the tiles and distance fields already fetched
+  void IntersectionRaycasts(
+    pul::core::SceneBundle &
+  , std::span<pul::physics::IntersectorRay const> rays
+  , std::span<pul::physics::IntersectionResults> intersectionResults
+  );
+
   pul::physics::TilemapLayer * TilemapLayer();
 
   bool IntersectionAabb(
@@ -62,6 +120,15 @@ namespace plugin::physics {
   , pul::physics::IntersectionResults &
   );
 
+  // sweeps the aabb along its velocity, returning the first contact with the
+  // collision layer. Geometry the aabb already overlaps is ignored so that it
+  // can always move out of it
+  bool IntersectionSweptAabb(
+    pul::core::SceneBundle &
+  , pul::physics::IntersectorSweptAabb const & sweep
+  , pul::physics::SweptIntersectionResults & intersectionResults
+  );
+
   bool IntersectionPoint(
     pul::core::SceneBundle &
   , pul::physics::IntersectorPoint const & point
@@ -8,6 +8,7 @@
 #include <pulcher-gfx/spritesheet.hpp>
 #include <pulcher-util/consts.hpp>
 #include <pulcher-util/enum.hpp>
+#include <pulcher-util/jobs.hpp>
 #include <pulcher-util/log.hpp>
 
 #include <cjson/cJSON.h>
@@ -17,6 +18,7 @@
 #include <imgui/imgui.hpp>
 #include <sokol/gfx.hpp>
 
+#include <algorithm>
 #include <fstream>
 
 // animation could always use cleaning / optimizing as a lot of it isn't based
@@ -152,11 +154,23 @@ std::tuple<
 , bool & skeletalFlip
 , float & skeletalRotation
 ) {
-  // okay the below is crazy with the map lookups, I need to cache the
-  // state somehow
-  auto & piece     = instance.animator->pieces[skeletal.label];
-  auto & stateInfo = instance.pieceToState[skeletal.label];
-  auto & state     = piece.states[stateInfo.label];
+  // the animator is shared between instances that are updated concurrently,
+  // so it is only read from; the empty fallbacks are never written to
+  static pul::animation::Animator::Piece emptyPiece = {};
+  static pul::animation::Animator::State emptyState = {};
+
+  auto & stateInfo = instance.pieceToState.AtIdx(skeletal.pieceIdx);
+
+  auto const & pieceList = instance.animator->pieceList;
+  auto & piece =
+      skeletal.pieceIdx < pieceList.size()
+    ? *pieceList[skeletal.pieceIdx] : emptyPiece
+  ;
+
+  auto & state =
+      stateInfo.stateIdx < piece.stateList.size()
+    ? *piece.stateList[stateInfo.stateIdx] : emptyState
+  ;
 
   // update skeletal information (origins, flip, rotation, etc)
   skeletalFlip ^= stateInfo.flip;
@@ -182,6 +196,23 @@ std::tuple<
   return { piece, stateInfo, state, componentsPtr };
 }
 
+pul::animation::Instance::StateInfo::VertexInputs PieceVertexInputs(
+  pul::animation::Instance::StateInfo const & stateInfo
+, std::vector<pul::animation::Component> const * components
+, bool const skeletalFlip
+) {
+  pul::animation::Instance::StateInfo::VertexInputs inputs;
+  inputs.skeletalMatrix = stateInfo.cachedLocalSkeletalMatrix;
+  inputs.components = components;
+  inputs.componentIt = stateInfo.componentIt;
+  inputs.uvCoordWrap = stateInfo.uvCoordWrap;
+  inputs.vertWrap = stateInfo.vertWrap;
+  inputs.skeletalFlip = skeletalFlip;
+  inputs.flipVertWrap = stateInfo.flipVertWrap;
+  inputs.visible = stateInfo.visible;
+  return inputs;
+}
+
 void ComputeVertices(
   pul::animation::Instance & instance
 , pul::animation::Animator::SkeletalPiece const & skeletal
@@ -189,15 +220,22 @@ void ComputeVertices(
 , bool & skeletalFlip
 , float & skeletalRotation
 , bool & forceUpdate
+, float const msElapsed
 ) {
   auto const & [piece, stateInfo, state, componentsPtr] =
     ComputeAnimationInfo(instance, skeletal, skeletalFlip, skeletalRotation);
 
   // if there are no components to render, output a degenerate tile
   if (!componentsPtr || componentsPtr->size() == 0ul) {
-    for (size_t it = 0ul; it < 6ul; ++ it) {
-      instance.uvCoordBufferData[indexOffset + it] = glm::vec2(-1);
-      instance.originBufferData[indexOffset + it] = glm::vec3(-1);
+    auto const inputs =
+      ::PieceVertexInputs(stateInfo, componentsPtr, skeletalFlip);
+
+    if (forceUpdate || stateInfo.vertexInputs != inputs) {
+      stateInfo.vertexInputs = inputs;
+      for (size_t it = 0ul; it < 6ul; ++ it) {
+        instance.uvCoordBufferData[indexOffset + it] = glm::vec2(-1);
+        instance.originBufferData[indexOffset + it] = glm::vec3(-1);
+      }
     }
 
     indexOffset += 6ul;
@@ -221,7 +259,7 @@ void ComputeVertices(
   float const msDeltaTime = state.MsDeltaTime(component);
 
   if (msDeltaTime > 0.0f && !stateInfo.animationFinished) {
-    stateInfo.deltaTime += pul::util::MsPerFrame;
+    stateInfo.deltaTime += msElapsed;
     if (stateInfo.deltaTime > msDeltaTime) {
       if (state.loops) {
         stateInfo.deltaTime = stateInfo.deltaTime - msDeltaTime;
@@ -240,6 +278,16 @@ void ComputeVertices(
     }
   }
 
+  // only pieces whose matrix, frame or wrapping changed since their vertices
+  // were computed are updated
+  auto const inputs =
+    ::PieceVertexInputs(stateInfo, componentsPtr, skeletalFlip);
+
+  if (stateInfo.vertexInputs != inputs) {
+    stateInfo.vertexInputs = inputs;
+    hasUpdate = true;
+  }
+
   if (!hasUpdate) {
     indexOffset += 6ul;
     return;
@@ -247,6 +295,10 @@ void ComputeVertices(
 
   auto pieceDimensions = glm::vec2(piece.dimensions);
 
+  auto uvCoordOffset = glm::vec2(instance.animator->uvCoordOffset);
+  if (instance.spritesheet == instance.animator->atlas)
+    { uvCoordOffset += glm::vec2(instance.animator->atlasOrigin); }
+
   // update origins & UV coords
   for (size_t it = 0ul; it < 6; ++ it, ++ indexOffset) {
     auto v = pul::util::TriangleVertexArray()[it];
@@ -272,9 +324,9 @@ void ComputeVertices(
     instance.uvCoordBufferData[indexOffset] =
       (
           (uv*pieceDimensions + glm::vec2(component.tile)*pieceDimensions)
-        + glm::vec2(instance.animator->uvCoordOffset)
+        + uvCoordOffset
       )
-      * instance.animator->spritesheet.InvResolution()
+      * instance.spritesheet->InvResolution()
     ;
     auto origin = glm::vec3(v*pieceDimensions, 1.0f);
 
@@ -296,6 +348,7 @@ void ComputeVertices(
 , bool const skeletalFlip
 , float const skeletalRotation
 , bool const forceUpdate
+, float const msElapsed
 ) {
   for (auto const & skeletal : skeletals) {
     // compute origin / uv coords
@@ -304,39 +357,27 @@ void ComputeVertices(
     bool newForceUpdate = forceUpdate;
     ComputeVertices(
       instance, skeletal, indexOffset
-    , newSkeletalFlip, newSkeletalRotation, newForceUpdate
+    , newSkeletalFlip, newSkeletalRotation, newForceUpdate, msElapsed
     );
 
     // continue to children
     ComputeVertices(
       instance, skeletal.children, indexOffset
-    , newSkeletalFlip, newSkeletalRotation, newForceUpdate
+    , newSkeletalFlip, newSkeletalRotation, newForceUpdate, msElapsed
     );
   }
 }
 
-void ComputeCache(
-  pul::animation::Instance & instance
+void ComposeSkeletalMatrix(
+  pul::animation::Animator::Piece const & piece
+, pul::animation::Instance::StateInfo const & stateInfo
+, pul::animation::Animator::State & state
+, std::vector<pul::animation::Component> & components
 , pul::animation::Animator::SkeletalPiece const & skeletal
 , glm::mat3 & skeletalMatrix
-, bool & skeletalFlip
-, float & skeletalRotation
+, bool const skeletalFlip
+, float const skeletalRotation
 ) {
-  if (instance.hasCalculatedCachedInfo) { return; }
-
-
-  auto const & [piece, stateInfo, state, componentsPtr] =
-    ComputeAnimationInfo(instance, skeletal, skeletalFlip, skeletalRotation);
-
-  if (!componentsPtr || componentsPtr->size() == 0ul) { return; }
-
-  auto & components = *componentsPtr;
-
-  PUL_ASSERT_CMP(
-    stateInfo.componentIt, <, components.size()
-  , stateInfo.componentIt = components.size()-1;
-  );
-
   auto & component = components[stateInfo.componentIt];
 
   // -- compose skeletal matrix
@@ -398,14 +439,55 @@ void ComputeCache(
     );
 
   skeletalMatrix = skeletalMatrix * localMatrix;
+}
+
+void ComputeCache(
+  pul::animation::Instance & instance
+, pul::animation::Animator::SkeletalPiece const & skeletal
+, glm::mat3 & skeletalMatrix
+, bool & skeletalFlip
+, float & skeletalRotation
+) {
+  if (instance.hasCalculatedCachedInfo) { return; }
 
-  // cache matrix
-  stateInfo.cachedLocalSkeletalMatrix = skeletalMatrix;
+
+  auto const & [piece, stateInfo, state, componentsPtr] =
+    ComputeAnimationInfo(instance, skeletal, skeletalFlip, skeletalRotation);
+
+  if (!componentsPtr || componentsPtr->size() == 0ul) { return; }
+
+  auto & components = *componentsPtr;
+
+  PUL_ASSERT_CMP(
+    stateInfo.componentIt, <, components.size()
+  , stateInfo.componentIt = components.size()-1;
+  );
+
+  // the matrix of an idle piece is kept from when it was last composed, the
+  // delta time only moves the origin of states that interpolate it
+  pul::animation::Instance::StateInfo::CacheInputs const inputs = {
+    skeletalMatrix, componentsPtr, stateInfo.componentIt
+  , state.originInterpolates ? stateInfo.deltaTime : 0.0f
+  , skeletalRotation, skeletalFlip
+  };
+
+  if (stateInfo.cacheInputs == inputs) {
+    skeletalMatrix = stateInfo.cachedLocalSkeletalMatrix;
+  } else {
+    ::ComposeSkeletalMatrix(
+      piece, stateInfo, state, components, skeletal
+    , skeletalMatrix, skeletalFlip, skeletalRotation
+    );
+
+    // cache matrix
+    stateInfo.cacheInputs = inputs;
+    stateInfo.cachedLocalSkeletalMatrix = skeletalMatrix;
+  }
 
   // the piece origin is only part of the local matrix, so it must be
   // recomposed, but apply the flipping
   {
-    localOrigin = piece.origin;
+    glm::vec2 localOrigin = piece.origin;
     if (skeletalFlip)
       { localOrigin.x = piece.dimensions.x - localOrigin.x; }
     skeletalMatrix =
@@ -440,19 +522,45 @@ void plugin::animation::ComputeCache(
 void plugin::animation::ComputeVertices(
   pul::animation::Instance & instance
 , bool forceUpdate
+, float const msElapsed
 ) {
+  // uv coords wrapped past their piece would sample the neighbours of the
+  // spritesheet in its atlas page, those instances keep to the spritesheet
+  auto const * spritesheet = &instance.animator->spritesheet;
+  if (instance.animator->atlas) {
+    bool wrapsUvCoords = false;
+    for (auto const & stateInfo : instance.pieceToState) {
+      auto const & uvCoordWrap = stateInfo.uvCoordWrap;
+      wrapsUvCoords = wrapsUvCoords || uvCoordWrap.x > 1.0f;
+      wrapsUvCoords = wrapsUvCoords || uvCoordWrap.y > 1.0f;
+    }
+
+    if (!wrapsUvCoords) { spritesheet = instance.animator->atlas; }
+  }
+
+  // every uv coord has to be recomputed against the new texture
+  if (instance.spritesheet != spritesheet) {
+    instance.spritesheet = spritesheet;
+    forceUpdate = true;
+  }
+
   size_t indexOffset = 0ul;
   ::ComputeVertices(
     instance, instance.animator->skeleton
-  , indexOffset, false, 0.0f, forceUpdate
+  , indexOffset, false, 0.0f, forceUpdate, msElapsed
   );
 }
 
 namespace {
 
+// for after the editor added or removed a piece, state or skeletal piece
 void ReconstructInstances(pul::core::SceneBundle & scene) {
   auto & registry = scene.EnttRegistry();
   auto & system = scene.AnimationSystem();
+
+  for (auto & animatorPair : system.animators)
+    { std::get<1>(animatorPair)->IndexPieces(); }
+
   auto view = registry.view<pul::animation::ComponentInstance>();
   for (auto entity : view) {
     auto & self = view.get<pul::animation::ComponentInstance>(entity);
@@ -464,6 +572,27 @@ void ReconstructInstances(pul::core::SceneBundle & scene) {
   }
 }
 
+// the editor changes the animator in place, which is not part of the inputs
+// its instances compare against to tell whether a piece changed
+void InvalidateInstances(
+  pul::core::SceneBundle & scene
+, pul::animation::Animator const & animator
+) {
+  auto & registry = scene.EnttRegistry();
+
+  auto view = registry.view<pul::animation::ComponentInstance>();
+  for (auto entity : view) {
+    auto & instance =
+      view.get<pul::animation::ComponentInstance>(entity).instance;
+    if (instance.animator.get() != &animator) { continue; }
+
+    for (auto & stateInfo : instance.pieceToState) {
+      stateInfo.cacheInputs = {};
+      stateInfo.vertexInputs = {};
+    }
+  }
+}
+
 void ImGuiRenderSpritesheetTile(
   pul::animation::Animator & animator
 , pul::animation::Animator::Piece & piece
@@ -940,12 +1069,117 @@ cJSON * LoadJsonFile(std::string const & filename) {
   return fileDataJson;
 }
 
+// animator spritesheets are packed into pages of at most this size, a
+// spritesheet that does not fit is drawn on its own
+constexpr size_t atlasPageDim = 4096ul;
+
+// transparent texels between packed spritesheets, so that a uv coord on the
+// edge of a piece does not round into its neighbour
+constexpr size_t atlasPadding = 1ul;
+
+struct AtlasEntry {
+  pul::animation::Animator * animator;
+  pul::gfx::Image image;
+};
+
+void PackAtlases(
+  pul::animation::System & system, std::vector<AtlasEntry> & entries
+) {
+  // shelf packing, tallest first so each shelf wastes little of its height
+  std::sort(
+    entries.begin(), entries.end()
+  , [](AtlasEntry const & a, AtlasEntry const & b) {
+      return
+          a.image.height != b.image.height
+        ? a.image.height > b.image.height
+        : a.image.width > b.image.width
+      ;
+    }
+  );
+
+  struct Page {
+    pul::gfx::Image image;
+    size_t shelfX = 0ul, shelfY = 0ul, shelfHeight = 0ul;
+    std::vector<std::pair<pul::animation::Animator *, glm::uvec2>> animators;
+  };
+
+  std::vector<Page> pages;
+
+  for (auto & entry : entries) {
+    size_t const width  = entry.image.width  + atlasPadding;
+    size_t const height = entry.image.height + atlasPadding;
+    if (
+        entry.image.data.empty()
+     || width > ::atlasPageDim || height > ::atlasPageDim
+    ) {
+      continue;
+    }
+
+    if (!pages.empty() && pages.back().shelfX + width > ::atlasPageDim) {
+      auto & page = pages.back();
+      page.shelfY += page.shelfHeight;
+      page.shelfX = 0ul;
+      page.shelfHeight = 0ul;
+    }
+
+    if (pages.empty() || pages.back().shelfY + height > ::atlasPageDim) {
+      auto & page = pages.emplace_back();
+      page.image.width = page.image.height = ::atlasPageDim;
+      page.image.data.resize(::atlasPageDim * ::atlasPageDim, glm::u8vec4(0));
+    }
+
+    auto & page = pages.back();
+
+    for (size_t y = 0ul; y < entry.image.height; ++ y) {
+      std::copy(
+        entry.image.data.begin() + entry.image.Idx(0ul, y)
+      , entry.image.data.begin() + entry.image.Idx(0ul, y+1ul)
+      , page.image.data.begin() + page.image.Idx(page.shelfX, page.shelfY + y)
+      );
+    }
+
+    page.animators.emplace_back(
+      entry.animator, glm::uvec2(page.shelfX, page.shelfY)
+    );
+
+    page.shelfX += width;
+    page.shelfHeight = std::max(page.shelfHeight, height);
+  }
+
+  for (auto & page : pages) {
+    // the rows below the last shelf were never used
+    page.image.height = page.shelfY + page.shelfHeight;
+    page.image.data.resize(page.image.width * page.image.height);
+    page.image.filename =
+      fmt::format("animation atlas {}", system.atlases.size());
+
+    auto const & atlas =
+      system.atlases.emplace_back(
+        std::make_unique<pul::gfx::Spritesheet>(
+          pul::gfx::Spritesheet::Construct(page.image)
+        )
+      );
+
+    for (auto & [animator, origin] : page.animators) {
+      animator->atlas = atlas.get();
+      animator->atlasOrigin = origin;
+    }
+
+    spdlog::debug(
+      "packed {} spritesheets into '{}' ({}x{})"
+    , page.animators.size(), atlas->filename, atlas->width, atlas->height
+    );
+  }
+}
+
 void LoadAnimation(
   std::string const & filename
 , std::map<
     std::string
   , std::shared_ptr<pul::animation::Animator>
   > & animators
+, bool const headless
+, std::vector<AtlasEntry> & atlasEntries
 ) {
 
   cJSON * fileDataJson = ::LoadJsonFile(filename);
@@ -973,13 +1207,18 @@ void LoadAnimation(
     // store animator
     animators[animator->label] = animator;
 
-    animator->spritesheet =
-      pul::gfx::Spritesheet::Construct(
-        pul::gfx::Image::Construct(
-          cJSON_GetObjectItemCaseSensitive(sheetJson, "filename")->valuestring
-        )
+    auto image =
+      pul::gfx::Image::Construct(
+        cJSON_GetObjectItemCaseSensitive(sheetJson, "filename")->valuestring
       );
 
+    animator->spritesheet = pul::gfx::Spritesheet::Construct(image, !headless);
+
+    // the pixels are kept until every spritesheet is loaded to pack them
+    if (!headless) {
+      atlasEntries.emplace_back(AtlasEntry{animator.get(), std::move(image)});
+    }
+
     cJSON * pieceJson;
     cJSON_ArrayForEach(
       pieceJson, cJSON_GetObjectItemCaseSensitive(sheetJson, "animation-piece")
@@ -1110,6 +1349,8 @@ void LoadAnimation(
 
     // load skeleton
     ::JsonParseRecursiveSkeleton(sheetJson, animator->skeleton);
+
+    animator->IndexPieces();
   }
 
   cJSON_Delete(fileDataJson);
@@ -1122,7 +1363,7 @@ void plugin::animation::LoadAnimations(
 ) {
   auto & animationSystem = scene.AnimationSystem();
 
-  { // -- create buffer
+  if (!scene.config.headless) { // -- create buffer
     sg_buffer_desc desc = {};
     desc.size = ::animationBufferMaxSize;
     desc.usage = SG_USAGE_STREAM;
@@ -1143,6 +1384,8 @@ void plugin::animation::LoadAnimations(
     cJSON * spritesheetDataJson =
       ::LoadJsonFile("assets/base/spritesheets/data.json");
 
+    std::vector<::AtlasEntry> atlasEntries;
+
     cJSON * filenameJson;
     cJSON_ArrayForEach(
       filenameJson
@@ -1152,12 +1395,20 @@ void plugin::animation::LoadAnimations(
       ::LoadAnimation(
         std::string{filenameJson->valuestring}
       , animationSystem.animators
+      , scene.config.headless
+      , atlasEntries
       );
     }
 
     cJSON_Delete(spritesheetDataJson);
+
+    if (!scene.config.headless)
+      { ::PackAtlases(animationSystem, atlasEntries); }
   }
 
+  // nothing gets rendered without a GPU context
+  if (scene.config.headless) { return; }
+
   { // -- sokol animation program
     sg_shader_desc desc = {};
     desc.vs.uniform_blocks[0].size = sizeof(float) * 2;
@@ -1276,7 +1527,10 @@ void plugin::animation::LoadAnimations(
 void plugin::animation::Shutdown(pul::core::SceneBundle & scene) {
   auto & registry = scene.EnttRegistry();
 
-  ::SaveAnimations(scene.AnimationSystem());
+  // headless instances never edit animations, and many of them can run at
+  // once, so leave the files alone
+  if (!scene.config.headless)
+    { ::SaveAnimations(scene.AnimationSystem()); }
 
   { // -- delete sokol animation information
     auto view = registry.view<pul::animation::ComponentInstance>();
@@ -1288,26 +1542,43 @@ void plugin::animation::Shutdown(pul::core::SceneBundle & scene) {
     }
   }
 
-  sg_destroy_shader(scene.AnimationSystem().sgProgram);
-  sg_destroy_pipeline(scene.AnimationSystem().sgPipeline);
+  if (!scene.config.headless) {
+    sg_destroy_shader(scene.AnimationSystem().sgProgram);
+    sg_destroy_pipeline(scene.AnimationSystem().sgPipeline);
+  }
 
   scene.AnimationSystem() = {};
 }
 
 void plugin::animation::UpdateFrame(pul::core::SceneBundle & scene) {
   auto & registry = scene.EnttRegistry();
-  // update each component
+
+  // instances only touch their own state & read from their animator, so they
+  // can be updated in parallel
+  static std::vector<pul::animation::Instance *> instances;
+  instances.clear();
+
   auto view = registry.view<pul::animation::ComponentInstance>();
   for (auto entity : view) {
-    auto & self = view.get<pul::animation::ComponentInstance>(entity);
-
-    plugin::animation::ComputeCache(
-      self.instance, self.instance.animator->skeleton
-    , glm::mat3(1.0f), false, 0.0f
+    instances.emplace_back(
+      &view.get<pul::animation::ComponentInstance>(entity).instance
     );
-
-    plugin::animation::ComputeVertices(self.instance, true);
   }
+
+  scene.JobPool().ParallelFor(
+    instances.size(), 32ul
+  , [tickMs = scene.clock.tickMs](size_t const begin, size_t const end) {
+      for (size_t it = begin; it < end; ++ it) {
+        auto & instance = *instances[it];
+
+        plugin::animation::ComputeCache(
+          instance, instance.animator->skeleton, glm::mat3(1.0f), false, 0.0f
+        );
+
+        plugin::animation::ComputeVertices(instance, false, tickMs);
+      }
+    }
+  );
 }
 
 void plugin::animation::UpdateCache(
@@ -1346,8 +1617,18 @@ void plugin::animation::ConstructInstance(
     return;
   }
 
-  // set default values for pieces
+  // set default values for pieces, in the order the animator indexed them
+  auto & pieceToState = animationInstance.pieceToState;
+  pieceToState.animator = animationInstance.animator.get();
+  pieceToState.states.resize(animationInstance.animator->pieceList.size());
+
+  uint32_t pieceIdx = 0u;
   for (auto & piecePair : animationInstance.animator->pieces) {
+    auto & stateInfo = pieceToState.states[pieceIdx];
+    stateInfo.animator = animationInstance.animator;
+    stateInfo.pieceLabel = piecePair.first;
+    stateInfo.pieceIdx = pieceIdx ++;
+
     if (piecePair.second.states.begin() == piecePair.second.states.end()) {
       spdlog::error(
         "need at least one state for piece '{}' of '{}'"
@@ -1355,10 +1636,8 @@ void plugin::animation::ConstructInstance(
       );
       continue;
     }
-    auto & pieceToState = animationInstance.pieceToState[piecePair.first];
-    pieceToState.label = piecePair.second.states.begin()->first;
-    pieceToState.animator = animationInstance.animator;
-    pieceToState.pieceLabel = piecePair.first;
+    stateInfo.label = piecePair.second.states.begin()->first;
+    stateInfo.stateIdx = 0u;
   }
 
   { // -- compute initial sokol buffers
@@ -1429,10 +1708,8 @@ void plugin::animation::DebugUiDispatch(
       PUL_ASSERT(self.instance.animator, continue;);
 
       if (ImGui::TreeNode(self.instance.animator->label.c_str())) {
-        for (auto const & stateInfoPair : self.instance.pieceToState) {
-          auto & stateInfo = stateInfoPair.second;
-
-          pul::imgui::Text("part - '{}'", stateInfoPair.first);
+        for (auto const & stateInfo : self.instance.pieceToState) {
+          pul::imgui::Text("part - '{}'", stateInfo.pieceLabel);
           pul::imgui::Text("\torigin '{}'", self.instance.origin);
           pul::imgui::Text("\tlabel '{}'", stateInfo.label);
           pul::imgui::Text("\tdelta-time {}", stateInfo.deltaTime);
@@ -1454,12 +1731,13 @@ void plugin::animation::DebugUiDispatch(
           , mat[2][0], mat[2][1], mat[2][2]
           );
 
-          auto variationType =
-            self.instance.animator
-              ->pieces[stateInfoPair.first]
-              .states[stateInfoPair.second.label]
-              .variationType
-          ;
+          auto const & pieceList = self.instance.animator->pieceList;
+          auto variationType = pul::animation::VariationType::Size;
+          if (stateInfo.pieceIdx < pieceList.size()) {
+            auto const & stateList = pieceList[stateInfo.pieceIdx]->stateList;
+            if (stateInfo.stateIdx < stateList.size())
+              { variationType = stateList[stateInfo.stateIdx]->variationType; }
+          }
 
           pul::imgui::Text("\tvariation type '{}'", ToStr(variationType));
 
@@ -1506,7 +1784,8 @@ void plugin::animation::DebugUiDispatch(
       );
 
       if (animPlaying) {
-        animMsTimer += pul::util::MsPerFrame * scene.numCpuFrames;
+        animMsTimer +=
+          static_cast<size_t>(scene.clock.tickMs * scene.numCpuFrames);
 
         animMsTimer =
             animLoop
@@ -1517,6 +1796,8 @@ void plugin::animation::DebugUiDispatch(
 
     auto & animator = *editAnimator;
 
+    ::InvalidateInstances(scene, animator);
+
     ImGui::Begin("Animation Skeleton");
       ImGui::Separator();
       ImGui::Text("skeleton");
@@ -1559,6 +1840,7 @@ void plugin::animation::DebugUiDispatch(
         ) {
           if (pieceLabel != "") {
             animator.pieces[pieceLabel] = {};
+            ReconstructInstances(scene);
           }
           pieceLabel = "";
           ImGui::CloseCurrentPopup();
@@ -1585,6 +1867,7 @@ void plugin::animation::DebugUiDispatch(
         if (ImGui::BeginPopup("piece delete confirm")) {
           if (ImGui::Button("confirm deletion")) {
             animator.pieces.erase(animator.pieces.find(piecePair.first));
+            ReconstructInstances(scene);
             ImGui::EndPopup();
             ImGui::TreePop();
             break;
@@ -1617,6 +1900,7 @@ void plugin::animation::DebugUiDispatch(
             ) {
               if (newStateLabel != "") {
                 piece.states[newStateLabel] = {};
+                ReconstructInstances(scene);
               }
               newStateLabel = "";
               ImGui::CloseCurrentPopup();
@@ -1640,6 +1924,7 @@ void plugin::animation::DebugUiDispatch(
             if (ImGui::BeginPopup("state delete confirm")) {
               if (ImGui::Button("confirm deletion")) {
                 piece.states.erase(piece.states.find(statePair.first));
+                ReconstructInstances(scene);
                 ImGui::EndPopup();
                 ImGui::TreePop();
                 break;
@@ -1,15 +1,73 @@
 #include <plugin-base/animation/render.hpp>
 
-#include <plugin-base/animation/animation.hpp>
 #include <pulcher-animation/animation.hpp>
 #include <pulcher-core/scene-bundle.hpp>
 
+#include <algorithm>
+
 static size_t animationBufferMaxSize = 4096*4096*5; // ~50MB
 
+namespace {
+
+constexpr uint32_t pieceVertexCount = 6u;
+
+// a piece that is not rendered has all of its vertices at one point
+bool Degenerate(glm::vec3 const * pieceOrigins) {
+  for (uint32_t it = 1u; it < pieceVertexCount; ++ it)
+    { if (pieceOrigins[it] != pieceOrigins[0]) { return false; } }
+  return true;
+}
+
+// a piece shows the same frame, flipped the same way, only if all of its uv
+// coords match
+bool SameFrame(glm::vec2 const * previousUvs, glm::vec2 const * currentUvs) {
+  for (uint32_t it = 0u; it < pieceVertexCount; ++ it)
+    { if (previousUvs[it] != currentUvs[it]) { return false; } }
+  return true;
+}
+
+} // -- namespace
+
+void plugin::animation::RenderSnapshot::Clear() {
+  this->ids.resize(0);
+  this->origins.resize(0);
+  this->spritesheets.resize(0);
+  this->vertexOffsets.resize(0);
+  this->vertexCounts.resize(0);
+  this->vertexOrigins.resize(0);
+  this->vertexUvCoords.resize(0);
+}
+
+void plugin::animation::RenderSnapshot::Add(
+  size_t const id
+, pul::animation::Instance const & instance
+) {
+  if (!instance.spritesheet || instance.originBufferData.empty()) { return; }
+
+  this->ids.emplace_back(id);
+  this->origins.emplace_back(instance.origin);
+  this->spritesheets.emplace_back(instance.spritesheet);
+  this->vertexOffsets.emplace_back(
+    static_cast<uint32_t>(this->vertexOrigins.size())
+  );
+  this->vertexCounts.emplace_back(
+    static_cast<uint32_t>(instance.originBufferData.size())
+  );
+
+  this->vertexOrigins.insert(
+    this->vertexOrigins.end()
+  , instance.originBufferData.begin(), instance.originBufferData.end()
+  );
+  this->vertexUvCoords.insert(
+    this->vertexUvCoords.end()
+  , instance.uvCoordBufferData.begin(), instance.uvCoordBufferData.end()
+  );
+}
+
 void plugin::animation::RenderInterpolated(
   pul::core::SceneBundle const & scene
 , pul::core::RenderBundleInstance const & interpolatedBundle
-, std::vector<plugin::animation::Interpolant> const & interpolants
+, plugin::animation::RenderSnapshot const & snapshot
 ) {
   // -- render animations
   auto & animationSystem = scene.AnimationSystem();
@@ -40,23 +98,49 @@ void plugin::animation::RenderInterpolated(
     { bufferData.reserve(animationBufferMaxSize / sizeof(glm::vec4)); }
   bufferData.resize(0); // doesn't affect capacity
 
-  // record each component to a buffer
-  for (auto & interpolant : interpolants) {
+  // instances are drawn batched by the texture they sample, an atlas page or
+  // a spritesheet, so that every texture costs a single draw no matter how
+  // many instances use it. The pipeline depth tests without blending, so the
+  // order of the batches does not change what ends up on screen
+  static std::vector<uint32_t> batchOrder;
+  batchOrder.resize(snapshot.Size());
+  for (size_t it = 0ul; it < batchOrder.size(); ++ it)
+    { batchOrder[it] = static_cast<uint32_t>(it); }
+
+  auto const & spritesheets = snapshot.spritesheets;
+  std::stable_sort(
+    batchOrder.begin(), batchOrder.end()
+  , [&spritesheets](uint32_t const a, uint32_t const b) {
+      return spritesheets[a]->handle < spritesheets[b]->handle;
+    }
+  );
 
-    auto & instance = interpolant.instance;
+  for (size_t batchBegin = 0ul; batchBegin < batchOrder.size();) {
+    auto const & spritesheet = *spritesheets[batchOrder[batchBegin]];
 
-    for (size_t it = 0; it < instance.originBufferData.size(); ++ it) {
-      auto const origin =
-        instance.originBufferData[it]
-      + glm::vec3(instance.origin, 0.0f)
-      ;
+    // record each component of the batch to a buffer
+    size_t batchEnd = batchBegin;
+    for (; batchEnd < batchOrder.size(); ++ batchEnd) {
+      uint32_t const instanceIdx = batchOrder[batchEnd];
+      if (spritesheets[instanceIdx]->handle != spritesheet.handle) { break; }
 
-      bufferData.emplace_back(glm::vec4(origin, 0.0f));
-      bufferData.emplace_back(
-        glm::vec4(instance.uvCoordBufferData[it], 0.0f, 0.0f)
-      );
+      auto const instanceOrigin =
+        glm::vec3(snapshot.origins[instanceIdx], 0.0f);
+      uint32_t const vertexOffset = snapshot.vertexOffsets[instanceIdx];
+      uint32_t const vertexCount = snapshot.vertexCounts[instanceIdx];
+
+      for (uint32_t it = vertexOffset; it < vertexOffset + vertexCount; ++ it) {
+        auto const origin = snapshot.vertexOrigins[it] + instanceOrigin;
+
+        bufferData.emplace_back(glm::vec4(origin, 0.0f));
+        bufferData.emplace_back(
+          glm::vec4(snapshot.vertexUvCoords[it], 0.0f, 0.0f)
+        );
+      }
     }
 
+    batchBegin = batchEnd;
+
     auto const offset =
       sg_append_buffer(
         *animationSystem.sgBuffer
@@ -66,7 +150,7 @@ void plugin::animation::RenderInterpolated(
     auto bindings = animationSystem.sgBindings;
     bindings.vertex_buffer_offsets[0] = offset;
     bindings.vertex_buffer_offsets[1] = offset;
-    bindings.fs_images[0] = instance.animator->spritesheet.Image();
+    bindings.fs_images[0] = spritesheet.Image();
     sg_apply_bindings(bindings);
 
     sg_draw(0, bufferData.size() / 2, 1);
@@ -77,51 +161,82 @@ void plugin::animation::RenderInterpolated(
 
 void plugin::animation::Interpolate(
   const float msDeltaInterp
-, InterpolantMap<plugin::animation::Interpolant> const & interpolantsPrev
-, InterpolantMap<plugin::animation::Interpolant> const & interpolantsCurr
-, std::vector<plugin::animation::Interpolant> & interpolantsOut
+, plugin::animation::RenderSnapshot const & previous
+, plugin::animation::RenderSnapshot const & current
+, plugin::animation::RenderSnapshot & output
 ) {
-  interpolantsOut.reserve(interpolantsPrev.size());
-
-  for (auto & interpolantPair : interpolantsPrev) {
-
-    auto const interpolantId = std::get<0>(interpolantPair);
-
-    auto const & previous = std::get<1>(interpolantPair).instance;
-
-    // locate current, if it doesn't exist then this object has been destroyed
-    auto currentPtr = interpolantsCurr.find(interpolantId);
-    if (currentPtr == interpolantsCurr.end()) { continue; }
-
-    auto & current  = std::get<1>(*currentPtr).instance;
-
-    // TODO
-    /* if (instance.automaticCachedMatrixCalculation) */
-    /*   { instance.hasCalculatedCachedInfo = false; } */
+  output.Clear();
+
+  // both are ordered by id so they are walked together, an instance that is
+  // not in the current snapshot has been destroyed
+  size_t currentIdx = 0ul;
+  for (
+    size_t previousIdx = 0ul; previousIdx < previous.Size(); ++ previousIdx
+  ) {
+    size_t const id = previous.ids[previousIdx];
+
+    while (currentIdx < current.Size() && current.ids[currentIdx] < id)
+      { ++ currentIdx; }
+
+    if (currentIdx == current.Size() || current.ids[currentIdx] != id)
+      { continue; }
+
+    uint32_t const previousOffset = previous.vertexOffsets[previousIdx];
+    uint32_t const currentOffset = current.vertexOffsets[currentIdx];
+    uint32_t const vertexCount = previous.vertexCounts[previousIdx];
+
+    output.ids.emplace_back(id);
+    output.origins.emplace_back(
+      glm::mix(
+        previous.origins[previousIdx], current.origins[currentIdx]
+      , msDeltaInterp
+      )
+    );
+    output.spritesheets.emplace_back(previous.spritesheets[previousIdx]);
+    output.vertexOffsets.emplace_back(
+      static_cast<uint32_t>(output.vertexOrigins.size())
+    );
+    output.vertexCounts.emplace_back(vertexCount);
 
-    // copy instance
-    auto interpolant = plugin::animation::Interpolant { previous };
-    auto & instance = interpolant.instance;
+    // the previous frame of every piece is kept, as is its texture
+    output.vertexUvCoords.insert(
+      output.vertexUvCoords.end()
+    , previous.vertexUvCoords.begin() + previousOffset
+    , previous.vertexUvCoords.begin() + previousOffset + vertexCount
+    );
 
-    // create an interpolated instance to compute vertices from
-    instance.origin = glm::mix(previous.origin, current.origin, msDeltaInterp);
+    // the pieces move by their vertices, which were computed from the
+    // skeletal matrices, and so follow the angles of the skeleton. Both are
+    // instances of the same animator if their vertex counts match, pieces
+    // that only one of them renders are not mixed. Neither are pieces that
+    // changed frame or flipped between the snapshots, as their vertices
+    // would squash through each other, e.g. when a player turns around
+    bool const piecesLineUp = current.vertexCounts[currentIdx] == vertexCount;
+
+    for (uint32_t pieceIt = 0u; pieceIt < vertexCount;) {
+      auto const * previousPiece =
+        &previous.vertexOrigins[previousOffset + pieceIt];
+      auto const * currentPiece =
+          piecesLineUp
+        ? &current.vertexOrigins[currentOffset + pieceIt] : nullptr
+      ;
 
-    for (auto & piecePair : instance.pieceToState) {
-      auto const & label = std::get<0>(piecePair);
-      auto & state = std::get<1>(piecePair);
-      auto const & statePrev = previous.pieceToState.at(label);
-      auto const & stateCurr = current.pieceToState.at(label);
+      bool const mixes =
+          currentPiece
+       && !::Degenerate(previousPiece) && !::Degenerate(currentPiece)
+       && ::SameFrame(
+            &previous.vertexUvCoords[previousOffset + pieceIt]
+          , &current.vertexUvCoords[currentOffset + pieceIt]
+          )
+      ;
 
-      state.angle = glm::mix(statePrev.angle, stateCurr.angle, msDeltaInterp);
+      for (uint32_t it = 0u; it < pieceVertexCount; ++ it, ++ pieceIt) {
+        output.vertexOrigins.emplace_back(
+          mixes
+            ? glm::mix(previousPiece[it], currentPiece[it], msDeltaInterp)
+            : previousPiece[it]
+        );
+      }
     }
-
-    // compute vertices
-    plugin::animation::ComputeCache(
-      instance, instance.animator->skeleton, glm::mat3(1.0f), false, 0.0f
-    );
-
-    plugin::animation::ComputeVertices(instance, true);
-
-    interpolantsOut.emplace_back(std::move(interpolant));
   }
 }
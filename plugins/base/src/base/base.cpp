@@ -4,6 +4,8 @@
 #include <plugin-base/debug/renderer.hpp>
 #include <plugin-base/entity/entity.hpp>
 #include <plugin-base/map/map.hpp>
+#include <plugin-base/network/prediction.hpp>
+#include <plugin-base/network/replication.hpp>
 #include <plugin-base/physics/physics.hpp>
 #include <plugin-base/ui/ui.hpp>
 
@@ -19,19 +21,65 @@ PUL_PLUGIN_DECL void Plugin_LogicUpdate(
   pul::core::SceneBundle & scene
 ) {
   plugin::entity::Update(scene);
+  plugin::physics::RecordHitboxHistory(scene);
   plugin::animation::UpdateFrame(scene);
 }
 
+PUL_PLUGIN_DECL void Plugin_CaptureSnapshot(
+  pul::core::SceneBundle const & scene
+, pul::network::Snapshot & snapshot
+) {
+  plugin::network::CaptureSnapshot(scene, snapshot);
+}
+
+PUL_PLUGIN_DECL void Plugin_ApplySnapshot(
+  pul::core::SceneBundle & scene
+, pul::network::Snapshot const & snapshot
+, uint32_t const localNetworkId
+, uint32_t const inputTick
+) {
+  plugin::network::ApplySnapshot(scene, snapshot, localNetworkId, inputTick);
+}
+
+PUL_PLUGIN_DECL void Plugin_CapturePlayerInput(
+  pul::core::SceneBundle const & scene
+, pul::network::PacketPlayerInput & input
+) {
+  plugin::network::CapturePlayerInput(scene, input);
+}
+
+PUL_PLUGIN_DECL void Plugin_ApplyNetworkPlayerInput(
+  pul::core::SceneBundle & scene
+, uint32_t const networkId
+, pul::network::PacketPlayerInput const * input
+) {
+  plugin::network::ApplyNetworkPlayerInput(scene, networkId, input);
+}
+
+PUL_PLUGIN_DECL uint32_t Plugin_ConstructNetworkPlayer(
+  pul::core::SceneBundle & scene
+) {
+  return plugin::network::ConstructNetworkPlayer(scene);
+}
+
+PUL_PLUGIN_DECL void Plugin_DestroyNetworkPlayer(
+  pul::core::SceneBundle & scene, uint32_t const networkId
+) {
+  plugin::network::DestroyNetworkPlayer(scene, networkId);
+}
+
 PUL_PLUGIN_DECL void Plugin_Initialize(pul::core::SceneBundle & scene) {
   plugin::animation::LoadAnimations(scene);
-  scene.AudioSystem().Initialize();
+  if (!scene.config.headless)
+    { scene.AudioSystem().Initialize(); }
   plugin::map::LoadMap(scene, scene.config.mapPath.string().c_str());
 
   // last thing so all previous information has been loaded up
   plugin::entity::StartScene(scene);
 
   // initialize debug
-  plugin::debug::ShapesRenderInitialize();
+  if (!scene.config.headless)
+    { plugin::debug::ShapesRenderInitialize(); }
 }
 
 PUL_PLUGIN_DECL void Plugin_LoadMap(
@@ -42,11 +90,16 @@ PUL_PLUGIN_DECL void Plugin_LoadMap(
 
 PUL_PLUGIN_DECL void Plugin_Shutdown(pul::core::SceneBundle & scene) {
   plugin::animation::Shutdown(scene);
-  scene.AudioSystem().Shutdown();
-  plugin::map::Shutdown();
+  if (!scene.config.headless)
+    { scene.AudioSystem().Shutdown(); }
+  plugin::map::Shutdown(scene);
   plugin::physics::ClearMapGeometry();
+  plugin::physics::ClearHitboxHistory();
   plugin::entity::Shutdown(scene);
-  plugin::debug::ShapesRenderShutdown();
+  plugin::network::Shutdown();
+  plugin::network::ClearPredictions();
+  if (!scene.config.headless)
+    { plugin::debug::ShapesRenderShutdown(); }
 }
 
 PUL_PLUGIN_DECL void Plugin_DebugUiDispatch(pul::core::SceneBundle & scene) {
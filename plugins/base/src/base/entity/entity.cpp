@@ -7,6 +7,7 @@
 #include <plugin-base/entity/cursor.hpp>
 #include <plugin-base/entity/player.hpp>
 #include <plugin-base/entity/weapon.hpp>
+#include <plugin-base/network/prediction.hpp>
 #include <plugin-base/physics/physics.hpp>
 
 #include <pulcher-animation/animation.hpp>
@@ -46,11 +47,14 @@ void plugin::entity::StartScene(pul::core::SceneBundle & scene) {
   // load config
   plugin::config::LoadConfig();
 
-  plugin::entity::ConstructCursor(scene);
+  if (!scene.config.headless)
+    { plugin::entity::ConstructCursor(scene); }
 
-  // player
-  entt::entity playerEntity;
-  plugin::entity::ConstructPlayer(playerEntity, scene, true);
+  // player, nobody plays on a headless instance; they join over the network
+  if (!scene.config.headless) {
+    entt::entity playerEntity;
+    plugin::entity::ConstructPlayer(playerEntity, scene, true);
+  }
 
   // bot/AI
   for (size_t i = 0; i < 1; ++ i) {
@@ -62,8 +66,9 @@ void plugin::entity::StartScene(pul::core::SceneBundle & scene) {
 void plugin::entity::Shutdown(pul::core::SceneBundle & scene) {
   auto & registry = scene.EnttRegistry();
 
-  // save config
-  plugin::config::SaveConfig();
+  // save config, headless instances never edit it
+  if (!scene.config.headless)
+    { plugin::config::SaveConfig(); }
 
   // store player
   auto view =
@@ -88,6 +93,8 @@ void plugin::entity::Shutdown(pul::core::SceneBundle & scene) {
 void plugin::entity::Update(pul::core::SceneBundle & scene) {
   auto & registry = scene.EnttRegistry();
 
+  plugin::physics::RebuildEntityBroadphase(scene);
+
   { // -- projectile exploder
     auto view =
       registry.view<
@@ -96,14 +103,46 @@ void plugin::entity::Update(pul::core::SceneBundle & scene) {
       , pul::core::ComponentParticle
       >();
 
+    // -- trace every projectile against the collision layer in one batch
+    std::vector<entt::entity> projectiles;
+    std::vector<pul::physics::IntersectorRay> projectileRays;
+
+    float const tickScale = scene.clock.TickScale();
+
     for (auto entity : view) {
+      auto & animation = view.get<pul::animation::ComponentInstance>(entity);
+      auto & particle = view.get<pul::core::ComponentParticle>(entity);
+
+      projectiles.emplace_back(entity);
+      projectileRays.emplace_back(
+        pul::physics::IntersectorRay::Construct(
+          animation.instance.origin,
+          animation.instance.origin + particle.velocity*tickScale
+        )
+      );
+    }
+
+    std::vector<pul::physics::IntersectionResults> projectileResults(
+      projectileRays.size()
+    );
+
+    plugin::physics::IntersectionRaycasts(
+      scene, projectileRays, projectileResults
+    );
+
+    for (size_t projectileIdx = 0ul; projectileIdx < projectiles.size();
+         ++ projectileIdx) {
+      auto const entity = projectiles[projectileIdx];
       auto & animation = view.get<pul::animation::ComponentInstance>(entity);
       auto & exploder = view.get<pul::core::ComponentParticleExploder>(entity);
       auto & particle = view.get<pul::core::ComponentParticle>(entity);
 
       bool explode =
           exploder.explodeOnDelete
-       && animation.instance.pieceToState["particle"].animationFinished
+       && animation
+            .instance
+            .pieceToState[pul::animation::PieceId::Particle]
+            .animationFinished
       ;
 
       entt::entity playerDirectHit = entt::null;
@@ -111,36 +150,28 @@ void plugin::entity::Update(pul::core::SceneBundle & scene) {
       glm::vec2 explodeOrigin = particle.origin;
 
       // check if physics bound
-      if (!explode) {
-        auto ray =
-          pul::physics::IntersectorRay::Construct(
-            animation.instance.origin,
-            animation.instance.origin + particle.velocity
-          );
-
-        if (
-          pul::physics::IntersectionResults results;
-          plugin::physics::IntersectionRaycast(scene, ray, results)
-        ) {
-          explodeOrigin = results.origin;
-          explode |= exploder.explodeOnCollide;
-        }
+      if (!explode && projectileResults[projectileIdx].collision) {
+        explodeOrigin = projectileResults[projectileIdx].origin;
+        explode |= exploder.explodeOnCollide;
       }
 
       // check for player
       if (!explode && exploder.damage.damagePlayer) {
-        playerDirectHit =
-          plugin::entity::WeaponDamageRaycast(
+        auto const directHit =
+          plugin::entity::WeaponDamageSweep(
             scene
-          , animation.instance.origin
-          , animation.instance.origin + particle.velocity
+          , animation.instance.origin, particle.velocity*tickScale
           , exploder.damage.playerDirectDamage
           , exploder.damage.explosionForce
           , exploder.damage.ignoredPlayer
-          ).entity
-        ;
+          );
 
-        explode |= playerDirectHit != entt::null;
+        playerDirectHit = directHit.entity;
+
+        if (playerDirectHit != entt::null) {
+          explodeOrigin = directHit.origin;
+          explode = true;
+        }
       }
 
       if (explode) {
@@ -193,128 +224,149 @@ void plugin::entity::Update(pul::core::SceneBundle & scene) {
       auto & particle = view.get<pul::core::ComponentParticleGrenade>(entity);
 
       bool destroyInstance =
-        animation.instance.pieceToState["particle"].animationFinished
+        animation
+          .instance
+          .pieceToState[pul::animation::PieceId::Particle]
+          .animationFinished
       ;
 
       // negate before comparison so that physics are ran on frame of
       // destruction
-      particle.timer -= pul::util::MsPerFrame;
+      particle.timer -= scene.clock.tickMs;
       if (particle.timer <= 0.0f) {
         destroyInstance = true;
       }
 
-      // check physics bounce
-      if (particle.velocity != glm::vec2()) {
+      // fast grenades are split into substeps so every bounce along the path
+      // of this tick gets resolved
+      float const tickScale = scene.clock.TickScale();
+      size_t const substeps =
+        scene.clock.Substeps(particle.velocity*tickScale);
+      float const substepScale = tickScale / static_cast<float>(substeps);
 
-        if (particle.gravityAffected)
-          { particle.velocity.y += 0.05f; }
+      entt::entity playerDirectHit = entt::null;
 
-        auto ray =
-          pul::physics::IntersectorRay::Construct(
-            animation.instance.origin,
-            animation.instance.origin + particle.velocity
-          );
+      for (size_t substep = 0ul; substep < substeps; ++ substep) {
+        // check physics bounce
+        if (particle.velocity != glm::vec2()) {
 
-        if (
-          pul::physics::IntersectionResults results;
-          plugin::physics::IntersectionRaycast(scene, ray, results)
-        ) {
-          // calculate normal (TODO this should be precomputed)
-          glm::vec2 normal = glm::vec2(0.0f);
-
-          for (auto point : std::vector<glm::vec2>{
-            { -1.0f, -1.0f }, { +0.0f, -1.0f }, { +1.0f, -1.0f }
-          , { -1.0f, +0.0f },                   { +1.0f, +0.0f }
-          , { -1.0f, +1.0f }, { +0.0f, +1.0f }, { +1.0f, +1.0f }
-          }) {
-            auto pointInt =
-              pul::physics::IntersectorPoint{
-                glm::i32vec2(glm::vec2(results.origin) + point)
-              };
-            if (
-              pul::physics::IntersectionResults pointResult;
-              plugin::physics::IntersectionPoint(scene, pointInt, pointResult)
-            ) {
-              normal += point;
-            }
-          }
-          normal = glm::normalize(normal);
-
-          // TODO have to detect normal of wall...
-          animation.instance.origin = results.origin;
-          particle.origin = results.origin;
-          // reflect velocity
-          glm::vec2 const targetDirection =
-            glm::reflect(glm::normalize(particle.velocity), -normal);
-          particle.velocity =
-              glm::length(particle.velocity)
-            * targetDirection
-            * particle.velocityFriction
-          ;
+          if (particle.gravityAffected)
+            { particle.velocity.y += 0.05f*substepScale; }
 
-          if (particle.useBounces && particle.bounces == 0) {
-            particle.velocity = {};
-            destroyInstance = true;
-          }
+          auto ray =
+            pul::physics::IntersectorRay::Construct(
+              animation.instance.origin,
+              animation.instance.origin + particle.velocity*substepScale
+            );
 
           if (
-              (!particle.useBounces || particle.bounces != 0)
-           && particle.bounceAnimation != ""
+            pul::physics::IntersectionResults results;
+            plugin::physics::IntersectionRaycast(scene, ray, results)
           ) {
+            // calculate normal (TODO this should be precomputed)
+            glm::vec2 normal = glm::vec2(0.0f);
+
+            for (auto point : std::vector<glm::vec2>{
+              { -1.0f, -1.0f }, { +0.0f, -1.0f }, { +1.0f, -1.0f }
+            , { -1.0f, +0.0f },                   { +1.0f, +0.0f }
+            , { -1.0f, +1.0f }, { +0.0f, +1.0f }, { +1.0f, +1.0f }
+            }) {
+              auto pointInt =
+                pul::physics::IntersectorPoint{
+                  glm::i32vec2(glm::vec2(results.origin) + point)
+                };
+              if (
+                pul::physics::IntersectionResults pointResult;
+                plugin::physics::IntersectionPoint(
+                  scene, pointInt, pointResult
+                )
+              ) {
+                normal += point;
+              }
+            }
+            normal = glm::normalize(normal);
+
+            // TODO have to detect normal of wall...
+            animation.instance.origin = results.origin;
+            particle.origin = results.origin;
+            // reflect velocity
+            glm::vec2 const targetDirection =
+              glm::reflect(glm::normalize(particle.velocity), -normal);
+            particle.velocity =
+                glm::length(particle.velocity)
+              * targetDirection
+              * particle.velocityFriction
+            ;
+
+            if (particle.useBounces && particle.bounces == 0) {
+              particle.velocity = {};
+              destroyInstance = true;
+            }
 
-            pul::animation::Instance bounceAnimation;
-            plugin::animation::ConstructInstance(
-              scene, bounceAnimation, scene.AnimationSystem()
-            , particle.bounceAnimation.c_str()
-            );
+            if (
+                (!particle.useBounces || particle.bounces != 0)
+             && particle.bounceAnimation != ""
+            ) {
 
-            bounceAnimation
-              .pieceToState["particle"]
-              .Apply(particle.bounceAnimation, true);
+              pul::animation::Instance bounceAnimation;
+              plugin::animation::ConstructInstance(
+                scene, bounceAnimation, scene.AnimationSystem()
+              , particle.bounceAnimation.c_str()
+              );
 
-            bounceAnimation.pieceToState["particle"].angle
-              = animation.instance.pieceToState["particle"].angle;
+              auto & bounceState =
+                bounceAnimation.pieceToState[pul::animation::PieceId::Particle];
 
-            bounceAnimation.origin = animation.instance.origin;
+              bounceState.Apply(particle.bounceAnimation, true);
 
-            auto bounceAnimationEntity = registry.create();
+              bounceState.angle =
+                animation
+                  .instance
+                  .pieceToState[pul::animation::PieceId::Particle]
+                  .angle;
 
-            registry.emplace<pul::animation::ComponentInstance>(
-              bounceAnimationEntity, std::move(bounceAnimation)
-            );
+              bounceAnimation.origin = animation.instance.origin;
 
-            registry.emplace<pul::core::ComponentParticle>(
-              bounceAnimationEntity, bounceAnimation.origin
-            );
-          }
+              auto bounceAnimationEntity = registry.create();
 
-          -- particle.bounces;
-        }
-      }
+              registry.emplace<pul::animation::ComponentInstance>(
+                bounceAnimationEntity, std::move(bounceAnimation)
+              );
 
-      entt::entity playerDirectHit = entt::null;
+              registry.emplace<pul::core::ComponentParticle>(
+                bounceAnimationEntity, bounceAnimation.origin
+              );
+            }
 
-      if (!destroyInstance && particle.damage.damagePlayer) {
-        playerDirectHit =
-          plugin::entity::WeaponDamageRaycast(
-            scene
-          , animation.instance.origin
-          , animation.instance.origin + particle.velocity
-          , particle.damage.playerDirectDamage
-          , particle.damage.explosionForce
-          , particle.damage.ignoredPlayer
-          ).entity
-        ;
+            -- particle.bounces;
+          }
+        }
 
-        destroyInstance |= playerDirectHit != entt::null;
-      }
+        if (!destroyInstance && particle.damage.damagePlayer) {
+          float const substepCount = static_cast<float>(substeps);
+          playerDirectHit =
+            plugin::entity::WeaponDamageSweep(
+              scene
+            , animation.instance.origin, particle.velocity*substepScale
+            , particle.damage.playerDirectDamage
+            , particle.damage.explosionForce
+            , particle.damage.ignoredPlayer
+            , static_cast<float>(substep) / substepCount
+            , static_cast<float>(substep + 1ul) / substepCount
+            ).entity
+          ;
 
+          destroyInstance |= playerDirectHit != entt::null;
+        }
+
+        // TODO fix this
+        particle.origin += particle.velocity*substepScale;
+        animation.instance.origin += particle.velocity*substepScale;
 
-      // TODO fix this
-      particle.origin += particle.velocity;
-      animation.instance.origin += particle.velocity;
+        if (destroyInstance) { break; }
+      }
 
-      animation.instance.pieceToState["particle"].angle =
+      animation.instance.pieceToState[pul::animation::PieceId::Particle].angle =
         std::atan2(particle.velocity.x, particle.velocity.y);
 
       if (destroyInstance) {
@@ -362,6 +414,8 @@ void plugin::entity::Update(pul::core::SceneBundle & scene) {
       , pul::animation::ComponentInstance
       >();
 
+    float const tickScale = scene.clock.TickScale();
+
     for (auto entity : view) {
       auto & animation = view.get<pul::animation::ComponentInstance>(entity);
       auto & particle = view.get<pul::core::ComponentParticle>(entity);
@@ -369,22 +423,28 @@ void plugin::entity::Update(pul::core::SceneBundle & scene) {
       if (particle.velocity != glm::vec2()) {
         if (particle.gravityAffected) {
           if (particle.velocity.y < 8.0f) {
-            particle.velocity.y += 0.05f;
+            particle.velocity.y += 0.05f*tickScale;
           }
         }
 
-        if (particle.velocityModifierFn)
-          { particle.velocityModifierFn(particle.velocity); }
+        if (particle.velocityModifierFn) {
+          particle.velocityModifierFn(particle.velocity, scene.clock.tickMs);
+        }
 
         // TODO fix this
-        particle.origin += particle.velocity;
-        animation.instance.origin += particle.velocity;
+        particle.origin += particle.velocity*tickScale;
+        animation.instance.origin += particle.velocity*tickScale;
 
-        animation.instance.pieceToState["particle"].angle =
-          std::atan2(particle.velocity.x, particle.velocity.y);
+        animation.instance.pieceToState[pul::animation::PieceId::Particle]
+          .angle = std::atan2(particle.velocity.x, particle.velocity.y);
       }
 
-      if (animation.instance.pieceToState["particle"].animationFinished) {
+      if (
+        animation
+          .instance
+          .pieceToState[pul::animation::PieceId::Particle]
+          .animationFinished
+      ) {
         animation.instance = {};
         registry.destroy(entity);
       }
@@ -403,9 +463,9 @@ void plugin::entity::Update(pul::core::SceneBundle & scene) {
       auto & animation = view.get<pul::animation::ComponentInstance>(entity);
 
       if (!pickup.spawned) {
-        pickup.spawnTimer += pul::util::MsPerFrame;
+        pickup.spawnTimer += scene.clock.tickMs;
         if (pickup.spawnTimer >= pickup.spawnTimerSet) {
-          pickup.spawnTimer = 0ul;
+          pickup.spawnTimer = 0.0f;
           pickup.spawned = true;
 
           pul::audio::EventInfo audioEvent;
@@ -416,13 +476,11 @@ void plugin::entity::Update(pul::core::SceneBundle & scene) {
         }
       }
 
-      animation.instance.pieceToState["pickups"].visible = pickup.spawned;
-      if (
-          animation.instance.pieceToState.find("pickup-bg")
-       != animation.instance.pieceToState.end()
-      ) {
-        animation.instance.pieceToState["pickup-bg"].visible = pickup.spawned;
-      }
+      auto & pieceToState = animation.instance.pieceToState;
+      pieceToState[pul::animation::PieceId::Pickups].visible = pickup.spawned;
+
+      // not every pickup has a background, then this goes to no piece
+      pieceToState[pul::animation::PieceId::PickupBg].visible = pickup.spawned;
 
       animation.instance.origin = pickup.origin;
     }
@@ -457,6 +515,35 @@ void plugin::entity::Update(pul::core::SceneBundle & scene) {
       , view.get<pul::animation::ComponentInstance>(entity)
       , damageable
       );
+
+      plugin::physics::UpdateEntityBroadphase(scene, entity);
+    }
+  }
+
+  { // -- network players, their input is applied before the update
+    auto view =
+      registry.view<
+        pul::controls::ComponentController
+      , pul::core::ComponentNetworkControllable
+      , pul::core::ComponentPlayer, pul::animation::ComponentInstance
+      , pul::core::ComponentDamageable
+      >();
+
+    for (auto entity : view) {
+      auto & origin = registry.get<pul::core::ComponentOrigin>(entity);
+      auto & hitbox = registry.get<pul::core::ComponentHitboxAABB>(entity);
+
+      plugin::entity::UpdatePlayer(
+        scene
+      , view.get<pul::controls::ComponentController>(entity).controller
+      , view.get<pul::core::ComponentPlayer>(entity)
+      , origin.origin
+      , hitbox
+      , view.get<pul::animation::ComponentInstance>(entity)
+      , view.get<pul::core::ComponentDamageable>(entity)
+      );
+
+      plugin::physics::UpdateEntityBroadphase(scene, entity);
     }
   }
 
@@ -512,6 +599,13 @@ void plugin::entity::Update(pul::core::SceneBundle & scene) {
       , damageable
       );
 
+      plugin::physics::UpdateEntityBroadphase(scene, entity);
+
+      // kept around to replay on top of the server's corrections
+      plugin::network::RecordPrediction(
+        scene, scene.PlayerController(), player, origin.origin
+      );
+
       // -- tracking camera
       // center camera on this
       glm::vec2 L = scene.PlayerController().current.lookOffset;
@@ -554,7 +648,7 @@ void plugin::entity::Update(pul::core::SceneBundle & scene) {
 
       auto const & playerAnim = *projectile.playerAnimation;
       auto const & weaponState =
-        playerAnim.pieceToState.at("weapon-placeholder");
+        playerAnim.pieceToState[pul::animation::PieceId::WeaponPlaceholder];
       auto const & weaponMatrix = weaponState.cachedLocalSkeletalMatrix;
 
       plugin::animation::UpdateCacheWithPrecalculatedMatrix(
@@ -616,12 +710,18 @@ void plugin::entity::Update(pul::core::SceneBundle & scene) {
         , emitter.animationInstance.animator->label.c_str()
         );
 
-        animationInstance
-          .pieceToState["particle"]
-          .Apply(emitter.animationInstance.animator->label.c_str(), true);
+        auto & particleState =
+          animationInstance.pieceToState[pul::animation::PieceId::Particle];
+
+        particleState.Apply(
+          emitter.animationInstance.animator->label.c_str(), true
+        );
 
-        animationInstance.pieceToState["particle"].angle
-          = animation.instance.pieceToState["particle"].angle;
+        particleState.angle =
+          animation
+            .instance
+            .pieceToState[pul::animation::PieceId::Particle]
+            .angle;
 
         animationInstance.origin = animation.instance.origin;
 
@@ -259,10 +259,11 @@ float CalculateAccelFromTarget(float timeMs, float targetTexels) {
 
 void ApplyGroundedMovement(
   float const facingDirection, float const playerVelocityX
-, float const accelTime, float const accelTarget
+, float const accelTime, float const accelTarget, float const tickScale
 , bool & inoutFrictionApplies, float & inoutInputAccel
 ) {
-  inoutInputAccel *= CalculateAccelFromTarget(accelTime, accelTarget);
+  inoutInputAccel *=
+    CalculateAccelFromTarget(accelTime, accelTarget) * tickScale;
 
   // check if we have not reached the target, in which case no
   // friction is applied. However if this frame would reach the target,
@@ -306,7 +307,10 @@ void PlayerCheckPickups(
 
     auto const pickupOrigin =
       glm::vec2(
-        animation.instance.pieceToState["pickups"].cachedLocalSkeletalMatrix
+        animation
+          .instance
+          .pieceToState[pul::animation::PieceId::Pickups]
+          .cachedLocalSkeletalMatrix
       * glm::vec3(pickup.origin, 1.0f)
       )
     ;
@@ -316,7 +320,7 @@ void PlayerCheckPickups(
       && glm::length(playerOriginCenter - pickupOrigin) < 32.0f
     ) {
       pickup.spawned = false;
-      pickup.spawnTimer = 0ul;
+      pickup.spawnTimer = 0.0f;
 
       { // audio pickup
         pul::audio::EventInfo audioEvent;
@@ -392,104 +396,37 @@ void UpdatePlayerPhysics(
   auto const & pointUl = ::pickPoints[Idx(::PickPointType::Ul)];
   auto const & pointLr = ::pickPoints[Idx(::PickPointType::Lr)];
 
-  // left/right/top/bottom layer
-  struct IterLayerInfo {
-    bool horizontal; // vertical or horizontal
-    bool alternative; // lines are alternative (ei top or bottom)
-  };
-
-
-  glm::vec2 closestIntersectionPlayerOriginOffset;
-  float closestIntersectionDistance = 99999.0f;
-  glm::vec2 closestPushDirection = {};
-  pul::physics::IntersectionResults closestIntersectionPointResults;
-
-  closestIntersectionPointResults.collision = false;
-
-  // left, right, top, bottom
-  for (auto const layer :
-    {
-      IterLayerInfo { false, false }, IterLayerInfo { false, true }
-    , IterLayerInfo { true,  false }, IterLayerInfo { true,  true }
-    }
-  ) {
-
-    int32_t pixXStart = 0, pixXEnd = 0, pixYStart = 0, pixYEnd = 0;
-
-    glm::vec2 pushDirection = {};
-
-    // select start/end point
-    if (layer.horizontal && layer.alternative) { // bottom
-      pixXStart = pointUl.x; pixXEnd = pointLr.x;
-      pixYStart = pointLr.y; pixYEnd = pointLr.y;
-      pushDirection = glm::vec2(0.0f, -1.0f);
-    } else if (layer.horizontal && !layer.alternative) { // top
-      pixXStart = pointUl.x; pixXEnd = pointLr.x;
-      pixYStart = pointUl.y; pixYEnd = pointUl.y;
-      pushDirection = glm::vec2(0.0f, +1.0f);
-    } else if (!layer.horizontal && layer.alternative) { // right
-      pixXStart = pointLr.x; pixXEnd = pointLr.x;
-      pixYStart = pointUl.y; pixYEnd = pointLr.y;
-      pushDirection = glm::vec2(-1.0f, 0.0f);
-    } else if (!layer.horizontal && !layer.alternative) { // left
-      pixXStart = pointUl.x; pixXEnd = pointUl.x;
-      pixYStart = pointUl.y; pixYEnd = pointLr.y;
-      pushDirection = glm::vec2(+1.0f, 0.0f);
+  // -- sweep the hitbox through the collision layer; on contact the velocity
+  //    into the surface is removed and the remaining displacement slides
+  //    along it. Contact normals are axis-aligned, so after two sweeps there
+  //    is nothing left to slide
+  glm::vec2 const sweepOffset =
+    glm::vec2(pointUl + pointLr + glm::i32vec2(1)) * 0.5f;
+  glm::vec2 const sweepDimensions =
+    glm::vec2(pointLr - pointUl + glm::i32vec2(1));
+
+  glm::vec2 displacement = player.velocity * scene.clock.TickScale();
+  for (size_t sweepIt = 0ul; sweepIt < 2ul; ++ sweepIt) {
+    if (displacement == glm::vec2(0.0f)) { break; }
+
+    pul::physics::IntersectorSweptAabb sweep;
+    sweep.origin = playerOrigin + sweepOffset;
+    sweep.dimensions = sweepDimensions;
+    sweep.velocity = displacement;
+
+    pul::physics::SweptIntersectionResults sweepResults;
+    if (!plugin::physics::IntersectionSweptAabb(scene, sweep, sweepResults)) {
+      playerOrigin += displacement;
+      break;
     }
 
-    // iteratee linearly (only one axis would be iterated through)
-    glm::i32vec2 pixIt = glm::i32vec2(pixXStart, pixYStart);
-
-    // apply initial iteration
-    if (layer.horizontal) { ++ pixIt.x; }
-    else                  { ++ pixIt.y; }
-
-    while (layer.horizontal ? (pixIt.x < pixXEnd) : (pixIt.y < pixYEnd)) {
-
-      glm::vec2 const origin = glm::round(glm::vec2(pixIt) + playerOrigin);
-
-      // apply intersection
-      auto pointRay =
-        pul::physics::IntersectorRay::Construct(
-          glm::round(origin + glm::sign(player.velocity))
-        , glm::round(origin + glm::vec2(player.velocity))
-        );
-      pul::physics::IntersectionResults pointResults;
-      plugin::physics::IntersectionRaycast(scene, pointRay, pointResults);
-
-      // update closest info
-      auto distToPlayer = glm::length(origin - glm::vec2(pointResults.origin));
-      if (
-            pointResults.collision
-         && distToPlayer >= 0.0f && distToPlayer < closestIntersectionDistance
-      ) {
-        closestIntersectionDistance = distToPlayer;
-        closestIntersectionPlayerOriginOffset = glm::vec2(pixIt);
-        closestPushDirection = pushDirection;
-        closestIntersectionPointResults = pointResults;
-      }
+    playerOrigin = sweepResults.origin - sweepOffset;
 
-      // apply iteration
-      if (layer.horizontal) { ++ pixIt.x; }
-      else                  { ++ pixIt.y; }
-    }
-  }
+    glm::vec2 const slide =
+      glm::vec2(1.0f) - glm::abs(glm::vec2(sweepResults.normal));
 
-  if (closestIntersectionPointResults.collision) {
-    spdlog::info("offset {} sign {}",
-      (closestIntersectionPlayerOriginOffset)
-    , glm::sign(closestIntersectionPlayerOriginOffset)
-      );
-    playerOrigin =
-      glm::vec2(closestIntersectionPointResults.origin)
-    - closestIntersectionPlayerOriginOffset
-    + closestPushDirection
-    ;
-    player.velocity =
-      player.velocity * (glm::vec2(1.0f) - glm::abs(closestPushDirection))
-    ;
-  } else {
-    playerOrigin += player.velocity;
+    player.velocity *= slide;
+    displacement *= slide * (1.0f - sweepResults.timeOfImpact);
   }
 
   player.prevGrounded = player.grounded;
@@ -557,8 +494,6 @@ void UpdatePlayerPhysics(
       player.wallClingLeft = true;
     }
   }
-
-  player.prevOrigin = playerOrigin;
 }
 
 void UpdatePlayerWeapon(
@@ -589,14 +524,15 @@ void UpdatePlayerWeapon(
   auto const & weaponMatrix =
     playerAnim
       .instance
-      .pieceToState["weapon-placeholder"]
+      .pieceToState[pul::animation::PieceId::WeaponPlaceholder]
       .cachedLocalSkeletalMatrix
   ;
 
-  bool const weaponFlip = playerAnim.instance.pieceToState["legs"].flip;
+  bool const weaponFlip =
+    playerAnim.instance.pieceToState[pul::animation::PieceId::Legs].flip;
 
   if (weapon.cooldown > 0.0f) {
-    weapon.cooldown -= pul::util::MsPerFrame;
+    weapon.cooldown -= scene.clock.tickMs;
     return; // do not execute weapon code
   } else {
     weapon.cooldown = 0.0f;
@@ -722,95 +658,40 @@ void UpdatePlayerWeapon(
   }
 }
 
-}
-
-void plugin::entity::ConstructPlayer(
-  entt::entity & entity
-, pul::core::SceneBundle & scene
-, bool mainPlayer
-) {
-  auto & registry = scene.EnttRegistry();
-  entity = registry.create();
-  registry.emplace<pul::core::ComponentPlayer>(entity);
-  auto damageable = pul::core::ComponentDamageable { 100, 0 };
-  registry.emplace<pul::core::ComponentDamageable>(entity, damageable);
-  registry.emplace<pul::core::ComponentOrigin>(entity);
-  registry.emplace<pul::controls::ComponentController>(entity);
-  registry.emplace<pul::core::ComponentCamera>(entity);
-  registry.emplace<pul::core::ComponentLabel>(entity, "Player");
-
-  pul::animation::Instance instance;
-  plugin::animation::ConstructInstance(
-    scene, instance, scene.AnimationSystem(), "nygelstromn"
-  );
-  registry.emplace<pul::animation::ComponentInstance>(
-    entity, std::move(instance)
-  );
-
-  auto & player = registry.get<pul::core::ComponentPlayer>(entity);
-  [[maybe_unused]]
-  auto & playerOrigin = registry.get<pul::core::ComponentOrigin>(entity);
-
-  { // hitbox
-    pul::core::ComponentHitboxAABB hitbox;
-    hitbox.dimensions = glm::i32vec2(15, 50);
-    registry.emplace<pul::core::ComponentHitboxAABB>(entity, hitbox);
-  }
-
-  // choose map origin
-  if (scene.PlayerMetaInfo().playerSpawnPoints.size() > 0ul) {
-    registry.get<pul::core::ComponentOrigin>(entity).origin =
-      scene.PlayerMetaInfo().playerSpawnPoints[0];
-  }
-
-  // load up player weapon animation & state from previous plugin load
-  if (mainPlayer) {
-
-    // overwrite with player component for persistent reloads
-    // TODO have this be toggleable
-    /* player = scene.StoredDebugPlayerComponent(); */
-
-    /* if (scene.StoredDebugPlayerOriginComponent().origin != glm::vec2(0.0f)) */
-    /*   { playerOrigin = scene.StoredDebugPlayerOriginComponent(); } */
-
-    registry.emplace<pul::core::ComponentPlayerControllable>(entity);
-  } else {
-    registry.emplace<pul::core::ComponentBotControllable>(entity);
-  }
-
-  // load weapon animation
-  pul::animation::Instance weaponInstance;
-  plugin::animation::ConstructInstance(
-    scene, weaponInstance, scene.AnimationSystem(), "weapons"
-  );
-  player.weaponAnimation = registry.create();
+// which movement events happened this tick, animation & audio react to them
+struct PlayerMovementEvents {
+  bool
+    verticalJump   = false
+  , horizontalJump = false
+  , verticalDash   = false
+  , horizontalDash = false
+  , walljump       = false
+  ;
 
-  registry.emplace<pul::animation::ComponentInstance>(
-    player.weaponAnimation, std::move(weaponInstance)
-  );
-}
+  bool startGrounded = false;
+  bool prevCrouchSliding = false;
+};
 
-void plugin::entity::UpdatePlayer(
+// the part of the player update that is driven by input & physics alone,
+// nothing presentational (animation, audio) and nothing that affects other
+// entities (weapons, pickups), so the client can replay it for prediction
+PlayerMovementEvents UpdatePlayerMovement(
   pul::core::SceneBundle & scene
 , pul::controls::Controller const & controls
 , pul::core::ComponentPlayer & player
 , glm::vec2 & playerOrigin
 , pul::core::ComponentHitboxAABB & hitbox
-, pul::animation::ComponentInstance & playerAnim
-, pul::core::ComponentDamageable & damageable
+, bool const legsAnimationFinished
+, pul::core::ComponentDamageable * damageable
 ) {
-
-  // add/remove 19 while doing calculations as it basically offsets the hitbox
-  // to the center
-  playerOrigin += glm::vec2(0.0f, 28.0f);
-
-  auto & registry = scene.EnttRegistry();
-
   auto const & controller = controls.current;
   auto const & controllerPrev = controls.previous;
 
   player.prevAirVelocity = player.velocity.y;
 
+  // accelerations are tuned per frame of pul::util::MsPerFrame
+  float const tickScale = scene.clock.TickScale();
+
   // error checking
   if (glm::abs(player.velocity.x) > 1000.0f) {
     spdlog::error("player velocity too high (for now)");
@@ -833,30 +714,25 @@ void plugin::entity::UpdatePlayer(
     player.storedVelocity.y = 0.0f;
   }
 
-  bool
-    frameVerticalJump   = false
-  , frameHorizontalJump = false
-  , frameVerticalDash   = false
-  , frameHorizontalDash = false
-  , frameWalljump       = false
-  ;
+  PlayerMovementEvents events;
+  events.startGrounded = player.grounded;
+  events.prevCrouchSliding = player.crouchSliding;
 
-  bool const frameStartGrounded = player.grounded;
-  bool const prevCrouchSliding = player.crouchSliding;
+  // update damageable, damage is never predicted
+  if (damageable) {
+    for (auto & damage : damageable->frameDamageInfos) {
+      player.velocity += damage.directionForce;
+      damageable->health = glm::max(damageable->health - damage.damage, 0);
 
-  // update damageable
-  for (auto & damage : damageable.frameDamageInfos) {
-    player.velocity += damage.directionForce;
-    damageable.health = glm::max(damageable.health - damage.damage, 0);
+      // pop origin up if grounded if there is Y force
+      if (player.grounded && damage.directionForce.y < 0.0f) {
+        playerOrigin.y -= 2.0f;
+      }
 
-    // pop origin up if grounded if there is Y force
-    if (player.grounded && damage.directionForce.y < 0.0f) {
-      playerOrigin.y -= 2.0f;
+      player.grounded = false;
     }
-
-    player.grounded = false;
+    damageable->frameDamageInfos = {};
   }
-  damageable.frameDamageInfos = {};
 
   using MovementControl = pul::controls::Controller::Movement;
 
@@ -870,16 +746,13 @@ void plugin::entity::UpdatePlayer(
         player.velocity.y +=
           ::CalculateAccelFromTarget(
             ::inputGravityAccelPreThresholdTime, ::inputGravityAccelThreshold
-          );
+          )
+        * tickScale;
       } else {
-        player.velocity.y += ::inputGravityAccelPostThreshold;
+        player.velocity.y += ::inputGravityAccelPostThreshold * tickScale;
       }
     }
 
-    // -- reset animation angles
-    playerAnim.instance.pieceToState["legs"].angle = 0.0f;
-    playerAnim.instance.pieceToState["body"].angle = 0.0f;
-
     // -- process crouching
     player.prevCrouching = player.crouching;
     player.crouching = controller.crouch;
@@ -887,29 +760,26 @@ void plugin::entity::UpdatePlayer(
     // check if player can uncrouch from geometry
     if (player.prevCrouching && !player.crouching) {
 
-      // just check the small gap on left/right side between crouch and stand
-      bool canUncrouch = true;
+      // just check the gap between the crouching and standing hitbox
+      auto const & pointUl = ::pickPoints[Idx(::PickPointType::Ul)];
+      auto const & pointLr = ::pickPoints[Idx(::PickPointType::Lr)];
 
-      for (
-        int32_t x = ::pickPoints[Idx(::PickPointType::Ul)].x;
-        x != ::pickPoints[Idx(::PickPointType::Lr)].x;
-        ++ x
-      ) {
-        auto const origin = playerOrigin + glm::vec2(x, 0.0f);
-        auto const pointRay =
-          pul::physics::IntersectorRay::Construct(
-            glm::round(origin + glm::vec2(0.0f, ::pickPointUpCrouch))
-          , glm::round(origin + glm::vec2(0.0f, ::pickPointUpStand))
-          );
-
-        pul::physics::IntersectionResults pointResults;
-        plugin::physics::IntersectionRaycast(scene, pointRay, pointResults);
+      pul::physics::IntersectorAabb gap;
+      gap.origin =
+        playerOrigin
+      + glm::vec2(
+          static_cast<float>(pointUl.x + pointLr.x + 1) * 0.5f
+        , static_cast<float>(::pickPointUpStand + ::pickPointUpCrouch) * 0.5f
+        );
+      gap.dimensions =
+        glm::vec2(
+          static_cast<float>(pointLr.x - pointUl.x + 1)
+        , static_cast<float>(::pickPointUpCrouch - ::pickPointUpStand)
+        );
 
-        if (pointResults.collision) {
-          canUncrouch = false;
-          break;
-        }
-      }
+      pul::physics::IntersectionResults gapResults;
+      bool const canUncrouch =
+        !plugin::physics::IntersectionAabb(scene, gap, gapResults);
 
       if (!canUncrouch) {
         player.crouching = true;
@@ -924,7 +794,7 @@ void plugin::entity::UpdatePlayer(
         player.crouchSliding
      && !player.jumping
      && glm::abs(player.velocity.x) >= inputCrouchAccelTarget
-     && !playerAnim.instance.pieceToState["legs"].animationFinished
+     && !legsAnimationFinished
     ) {
       player.crouching = true;
     }
@@ -943,10 +813,10 @@ void plugin::entity::UpdatePlayer(
     }
 
     if (player.crouchSlideCooldown > 0.0f)
-      { player.crouchSlideCooldown -= pul::util::MsPerFrame; }
+      { player.crouchSlideCooldown -= scene.clock.tickMs; }
 
     if (player.slideFrictionTime > 0.0f)
-      { player.slideFrictionTime -= pul::util::MsPerFrame; }
+      { player.slideFrictionTime -= scene.clock.tickMs; }
 
     // -- process jumping
     player.jumping = controller.jump;
@@ -957,7 +827,7 @@ void plugin::entity::UpdatePlayer(
     }
 
     if (player.jumpFallTime > 0.0f)
-      { player.jumpFallTime -= pul::util::MsPerFrame; }
+      { player.jumpFallTime -= scene.clock.tickMs; }
 
     if (!player.jumping) {
       player.storedVelocity = player.velocity;
@@ -972,7 +842,7 @@ void plugin::entity::UpdatePlayer(
     if ((player.jumpFallTime > 0.0f || player.grounded) && player.jumping) {
       if (controller.movementHorizontal == MovementControl::None) {
         player.velocity.y = -::jumpingVerticalAccel;
-        frameVerticalJump = true;
+        events.verticalJump = true;
       } else {
 
         float thetaRad = glm::radians(::jumpingHorizontalTheta);
@@ -987,7 +857,7 @@ void plugin::entity::UpdatePlayer(
           ;
         }
 
-        frameHorizontalJump = true;
+        events.horizontalJump = true;
       }
       player.grounded = false;
       player.hasReleasedJump = false;
@@ -1010,7 +880,7 @@ void plugin::entity::UpdatePlayer(
         player.velocity.y = glm::sin(thetaRad) * totalVel;
         player.velocity.x = glm::cos(thetaRad) * totalVel;
 
-        frameWalljump = true;
+        events.walljump = true;
       }
     }
 
@@ -1031,12 +901,15 @@ void plugin::entity::UpdatePlayer(
         if (controller.walk) {
           ApplyGroundedMovement(
             facingDirection, player.velocity.x
-          , ::inputWalkAccelTime, ::inputWalkAccelTarget
+          , ::inputWalkAccelTime, ::inputWalkAccelTarget, tickScale
           , frictionApplies, inputAccel
           );
         } else if (player.crouching) {
           if (
-              (player.prevGrounded ? !player.prevCrouching : !prevCrouchSliding)
+              (
+                player.prevGrounded
+                  ? !player.prevCrouching : !events.prevCrouchSliding
+              )
             && player.crouchSlideCooldown <= 0.0f
           ) {
             player.crouchSliding = true;
@@ -1055,14 +928,14 @@ void plugin::entity::UpdatePlayer(
           } else {
             ApplyGroundedMovement(
               facingDirection, player.velocity.x
-            , ::inputCrouchAccelTime, ::inputCrouchAccelTarget
+            , ::inputCrouchAccelTime, ::inputCrouchAccelTarget, tickScale
             , frictionApplies, inputAccel
             );
           }
         } else {
           ApplyGroundedMovement(
             facingDirection, player.velocity.x
-          , ::inputRunAccelTime, ::inputRunAccelTarget
+          , ::inputRunAccelTime, ::inputRunAccelTarget, tickScale
           , frictionApplies, inputAccel
           );
         }
@@ -1082,9 +955,10 @@ void plugin::entity::UpdatePlayer(
           ::CalculateAccelFromTarget(
             ::inputAirAccelPreThresholdTime
           , ::inputAirAccelThreshold
-          );
+          )
+        * tickScale;
       } else {
-        inputAccel *= ::inputAirAccelPostThreshold;
+        inputAccel *= ::inputAirAccelPostThreshold * tickScale;
       }
 
       // set ground accel to 0 on no input
@@ -1139,9 +1013,9 @@ void plugin::entity::UpdatePlayer(
               , ::slideFrictionTransitionPow
               )
           );
-        player.velocity.x *= friction;
+        player.velocity.x *= glm::pow(friction, tickScale);
       } else {
-        player.velocity.x *= ::frictionGrounded;
+        player.velocity.x *= glm::pow(::frictionGrounded, tickScale);
       }
     }
 
@@ -1156,20 +1030,20 @@ void plugin::entity::UpdatePlayer(
     // -- process dashing
     for (auto & playerDashCooldown : player.dashCooldown) {
       if (playerDashCooldown > 0.0f)
-        { playerDashCooldown -= pul::util::MsPerFrame; }
+        { playerDashCooldown -= scene.clock.tickMs; }
     }
 
     // clear dash lock if either we land, or we are jumping on this frame (thus
     // player will not be grounded)
     if (
         !player.prevGrounded
-     && (frameHorizontalJump || frameVerticalJump || player.grounded)
+     && (events.horizontalJump || events.verticalJump || player.grounded)
     ) {
       for (auto & dashLock : player.dashLock)
         { dashLock = false; }
     }
     if (player.dashZeroGravityTime > 0.0f) {
-      player.dashZeroGravityTime -= pul::util::MsPerFrame;
+      player.dashZeroGravityTime -= scene.clock.tickMs;
       // if grounded then gravity time has been nullified
       if (player.grounded || !controller.dash)
         { player.dashZeroGravityTime = 0.0f; }
@@ -1177,7 +1051,7 @@ void plugin::entity::UpdatePlayer(
 
     // player has a limited amount of dashes in air, so reset that if grounded
     // at the start of frame
-    if (frameStartGrounded)
+    if (events.startGrounded)
       { player.midairDashesLeft = ::maxAirDashes; }
 
     if (
@@ -1209,9 +1083,9 @@ void plugin::entity::UpdatePlayer(
       }
 
       if (controller.movementVertical != MovementControl::None) {
-        frameVerticalDash = true;
+        events.verticalDash = true;
       } else {
-        frameHorizontalDash = true;
+        events.horizontalDash = true;
       }
 
       auto direction =
@@ -1243,13 +1117,119 @@ void plugin::entity::UpdatePlayer(
 
   ::UpdatePlayerPhysics(scene, player, playerOrigin, hitbox);
 
+  return events;
+}
+
+}
+
+void plugin::entity::ConstructPlayer(
+  entt::entity & entity
+, pul::core::SceneBundle & scene
+, bool mainPlayer
+) {
+  auto & registry = scene.EnttRegistry();
+  entity = registry.create();
+  registry.emplace<pul::core::ComponentPlayer>(entity);
+  auto damageable = pul::core::ComponentDamageable { 100, 0 };
+  registry.emplace<pul::core::ComponentDamageable>(entity, damageable);
+  registry.emplace<pul::core::ComponentOrigin>(entity);
+  registry.emplace<pul::controls::ComponentController>(entity);
+  registry.emplace<pul::core::ComponentCamera>(entity);
+  registry.emplace<pul::core::ComponentLabel>(entity, "Player");
+
+  pul::animation::Instance instance;
+  plugin::animation::ConstructInstance(
+    scene, instance, scene.AnimationSystem(), "nygelstromn"
+  );
+  registry.emplace<pul::animation::ComponentInstance>(
+    entity, std::move(instance)
+  );
+
+  auto & player = registry.get<pul::core::ComponentPlayer>(entity);
+  [[maybe_unused]]
+  auto & playerOrigin = registry.get<pul::core::ComponentOrigin>(entity);
+
+  { // hitbox
+    pul::core::ComponentHitboxAABB hitbox;
+    hitbox.dimensions = glm::i32vec2(15, 50);
+    registry.emplace<pul::core::ComponentHitboxAABB>(entity, hitbox);
+  }
+
+  // choose map origin
+  if (scene.PlayerMetaInfo().playerSpawnPoints.size() > 0ul) {
+    registry.get<pul::core::ComponentOrigin>(entity).origin =
+      scene.PlayerMetaInfo().playerSpawnPoints[0];
+  }
+
+  // load up player weapon animation & state from previous plugin load
+  if (mainPlayer) {
+
+    // overwrite with player component for persistent reloads
+    // TODO have this be toggleable
+    /* player = scene.StoredDebugPlayerComponent(); */
+
+    /* if (scene.StoredDebugPlayerOriginComponent().origin != glm::vec2(0.0f)) */
+    /*   { playerOrigin = scene.StoredDebugPlayerOriginComponent(); } */
+
+    registry.emplace<pul::core::ComponentPlayerControllable>(entity);
+  } else {
+    registry.emplace<pul::core::ComponentBotControllable>(entity);
+  }
+
+  // load weapon animation
+  pul::animation::Instance weaponInstance;
+  plugin::animation::ConstructInstance(
+    scene, weaponInstance, scene.AnimationSystem(), "weapons"
+  );
+  player.weaponAnimation = registry.create();
+
+  registry.emplace<pul::animation::ComponentInstance>(
+    player.weaponAnimation, std::move(weaponInstance)
+  );
+}
+
+void plugin::entity::UpdatePlayer(
+  pul::core::SceneBundle & scene
+, pul::controls::Controller const & controls
+, pul::core::ComponentPlayer & player
+, glm::vec2 & playerOrigin
+, pul::core::ComponentHitboxAABB & hitbox
+, pul::animation::ComponentInstance & playerAnim
+, pul::core::ComponentDamageable & damageable
+) {
+  // add/remove 19 while doing calculations as it basically offsets the hitbox
+  // to the center
+  playerOrigin += glm::vec2(0.0f, 28.0f);
+
+  auto & registry = scene.EnttRegistry();
+
+  auto const & controller = controls.current;
+  auto const & controllerPrev = controls.previous;
+
+  using MovementControl = pul::controls::Controller::Movement;
+
+  auto & pieceToState = playerAnim.instance.pieceToState;
+  auto & legInfo = pieceToState[pul::animation::PieceId::Legs];
+  auto & bodyInfo = pieceToState[pul::animation::PieceId::Body];
+  auto & armBackInfo = pieceToState[pul::animation::PieceId::ArmBack];
+  auto & armFrontInfo = pieceToState[pul::animation::PieceId::ArmFront];
+
+  auto const events =
+    ::UpdatePlayerMovement(
+      scene, controls, player, playerOrigin, hitbox
+    , legInfo.animationFinished
+    , &damageable
+    );
+
   const float velocityXAbs = glm::abs(player.velocity.x);
 
   { // -- apply animations
 
+    // -- reset animation angles
+    legInfo.angle = 0.0f;
+    bodyInfo.angle = 0.0f;
+
     // -- set leg animation
-    auto & legInfo = playerAnim.instance.pieceToState["legs"];
-    auto & bodyInfo = playerAnim.instance.pieceToState["body"];
 
     if (player.grounded) { // grounded animations
       if (!player.crouchSliding) {
@@ -1259,9 +1239,8 @@ void plugin::entity::UpdatePlayer(
 
       if (!player.crouching && (!player.prevGrounded || player.landing)) {
         player.landing = true;
-        auto & stateInfo = playerAnim.instance.pieceToState["legs"];
-        stateInfo.Apply("landing");
-        if (stateInfo.animationFinished) { player.landing = false; }
+        legInfo.Apply("landing");
+        if (legInfo.animationFinished) { player.landing = false; }
       } else {
         // check walk/run animation turns before applying stand/walk/run
         bool const applyTurning = false;
@@ -1312,37 +1291,31 @@ void plugin::entity::UpdatePlayer(
       }
     } else { // air animations
 
-      playerAnim.instance.pieceToState["body"].Apply("center");
+      bodyInfo.Apply("center");
 
-      if (frameVerticalJump) {
-        playerAnim.instance.pieceToState["legs"].Apply("jump-high", true);
-      } else if (frameHorizontalJump) {
+      if (events.verticalJump) {
+        legInfo.Apply("jump-high", true);
+      } else if (events.horizontalJump) {
         static bool swap = false;
         swap ^= 1;
-        playerAnim
-          .instance.pieceToState["legs"]
-          .Apply(swap ? "jump-strafe-0" : "jump-strafe-1");
-      } else if (frameVerticalDash) {
-        playerAnim.instance.pieceToState["legs"].Apply("dash-vertical");
-      } else if (frameHorizontalDash) {
+        legInfo.Apply(swap ? "jump-strafe-0" : "jump-strafe-1");
+      } else if (events.verticalDash) {
+        legInfo.Apply("dash-vertical");
+      } else if (events.horizontalDash) {
         static bool swap = false;
         swap ^= 1;
-        playerAnim
-          .instance.pieceToState["legs"]
-          .Apply(swap ? "dash-horizontal-0" : "dash-horizontal-1");
-      } else if (frameWalljump) {
+        legInfo.Apply(swap ? "dash-horizontal-0" : "dash-horizontal-1");
+      } else if (events.walljump) {
         static bool swap = false;
         swap ^= 1;
-        playerAnim
-          .instance.pieceToState["legs"]
-          .Apply(swap ? "walljump-0" : "walljump-1");
+        legInfo.Apply(swap ? "walljump-0" : "walljump-1");
       } else if (player.prevGrounded) {
         // logically can only have falled down
-        playerAnim.instance.pieceToState["legs"].Apply("air-idle");
+        legInfo.Apply("air-idle");
       } else {
         if (legInfo.label == "dash-vertical" && legInfo.animationFinished) {
           // switch to air idle
-          playerAnim.instance.pieceToState["legs"].Apply("air-idle");
+          legInfo.Apply("air-idle");
         }
       }
     }
@@ -1351,39 +1324,39 @@ void plugin::entity::UpdatePlayer(
       pul::core::weaponInfo[Idx(player.inventory.currentWeapon)];
 
     // -- arm animation
-    bool playerDirFlip = playerAnim.instance.pieceToState["legs"].flip;
+    bool playerDirFlip = legInfo.flip;
     switch (currentWeaponInfo.requiredHands) {
       case 0:
         if (player.grounded) {
           if (player.crouching) {
-            playerAnim.instance.pieceToState["arm-back"].Apply("alarmed");
-            playerAnim.instance.pieceToState["arm-front"].Apply("alarmed");
+            armBackInfo.Apply("alarmed");
+            armFrontInfo.Apply("alarmed");
           }
           else if (legInfo.label == "walk" || legInfo.label == "walk-turn") {
-            playerAnim.instance.pieceToState["arm-back"].Apply("unequip-walk");
-            playerAnim.instance.pieceToState["arm-front"].Apply("unequip-walk");
+            armBackInfo.Apply("unequip-walk");
+            armFrontInfo.Apply("unequip-walk");
           }
           else if (legInfo.label == "run" || legInfo.label == "run-turn") {
-            playerAnim.instance.pieceToState["arm-back"].Apply("unequip-run");
-            playerAnim.instance.pieceToState["arm-front"].Apply("unequip-run");
+            armBackInfo.Apply("unequip-run");
+            armFrontInfo.Apply("unequip-run");
           } else {
-            playerAnim.instance.pieceToState["arm-back"].Apply("alarmed");
-            playerAnim.instance.pieceToState["arm-front"].Apply("alarmed");
+            armBackInfo.Apply("alarmed");
+            armFrontInfo.Apply("alarmed");
           }
         } else {
-          playerAnim.instance.pieceToState["arm-back"].Apply("alarmed");
-          playerAnim.instance.pieceToState["arm-front"].Apply("alarmed");
+          armBackInfo.Apply("alarmed");
+          armFrontInfo.Apply("alarmed");
         }
       break;
       case 1:
         if (playerDirFlip)
-          playerAnim.instance.pieceToState["arm-back"].Apply("equip-1H");
+          armBackInfo.Apply("equip-1H");
         else
-          playerAnim.instance.pieceToState["arm-front"].Apply("equip-1H");
+          armFrontInfo.Apply("equip-1H");
       break;
       case 2:
-        playerAnim.instance.pieceToState["arm-back"].Apply("equip-2H");
-        playerAnim.instance.pieceToState["arm-front"].Apply("equip-2H");
+        armBackInfo.Apply("equip-2H");
+        armFrontInfo.Apply("equip-2H");
       break;
     }
 
@@ -1400,19 +1373,16 @@ void plugin::entity::UpdatePlayer(
       playerDirFlip = false;
     }
 
-    playerAnim.instance.pieceToState["legs"].flip = playerDirFlip;
+    legInfo.flip = playerDirFlip;
 
     float const angle =
       std::atan2(controller.lookDirection.x, controller.lookDirection.y);
     player.lookAtAngle = angle;
     player.flip = playerDirFlip;
 
-    playerAnim.instance.pieceToState["arm-back"].angle
-      = playerAnim.instance.pieceToState["arm-front"].angle
-      = angle
-    ;
+    armBackInfo.angle = armFrontInfo.angle = angle;
 
-    playerAnim.instance.pieceToState["head"].angle = angle;
+    pieceToState[pul::animation::PieceId::Head].angle = angle;
 
     playerAnim.instance.origin = playerOrigin;
 
@@ -1420,7 +1390,8 @@ void plugin::entity::UpdatePlayer(
     // get the hand position
     {
       plugin::animation::UpdateCache(playerAnim.instance);
-      auto & handState = playerAnim.instance.pieceToState["weapon-placeholder"];
+      auto & handState =
+        pieceToState[pul::animation::PieceId::WeaponPlaceholder];
 
       char const * weaponStr = ToStr(player.inventory.currentWeapon);
 
@@ -1433,14 +1404,15 @@ void plugin::entity::UpdatePlayer(
       weaponAnimation.visible =
         player.inventory.currentWeapon != pul::core::WeaponType::Unarmed;
 
-      auto & weaponState = weaponAnimation.pieceToState["weapons"];
+      auto & weaponState =
+        weaponAnimation.pieceToState[pul::animation::PieceId::Weapons];
 
       weaponState.Apply(weaponStr);
 
       weaponAnimation.origin = playerAnim.instance.origin;
 
-      weaponState.angle = playerAnim.instance.pieceToState["arm-front"].angle;
-      weaponState.flip = playerAnim.instance.pieceToState["legs"].flip;
+      weaponState.angle = armFrontInfo.angle;
+      weaponState.flip = legInfo.flip;
 
       plugin::animation::UpdateCacheWithPrecalculatedMatrix(
         weaponAnimation, handState.cachedLocalSkeletalMatrix
@@ -1457,14 +1429,14 @@ void plugin::entity::UpdatePlayer(
   // -- set audio
   auto & audioSystem = scene.AudioSystem();
 
-  if (frameVerticalJump || frameHorizontalJump || frameWalljump) {
+  if (events.verticalJump || events.horizontalJump || events.walljump) {
     pul::audio::EventInfo audioEvent;
     audioEvent.event = pul::audio::event::Type::CharacterMovementJump;
     audioEvent.origin = playerOrigin;
     audioSystem.DispatchEventOneOff(audioEvent);
   }
 
-  if (player.crouchSliding && !prevCrouchSliding) {
+  if (player.crouchSliding && !events.prevCrouchSliding) {
     pul::audio::EventInfo audioEvent;
     audioEvent.event = pul::audio::event::Type::CharacterMovementSlide;
     audioEvent.params = { {"velocity.x", glm::abs(player.velocity.x)} };
@@ -1472,7 +1444,7 @@ void plugin::entity::UpdatePlayer(
     audioSystem.DispatchEventOneOff(audioEvent);
   }
 
-  if (frameHorizontalDash || frameVerticalDash) {
+  if (events.horizontalDash || events.verticalDash) {
     pul::audio::EventInfo audioEvent;
     audioEvent.event = pul::audio::event::Type::CharacterMovementDash;
     audioEvent.origin = playerOrigin;
@@ -1486,8 +1458,6 @@ void plugin::entity::UpdatePlayer(
     audioSystem.DispatchEventOneOff(audioEvent);
   }
 
-  auto & legInfo = playerAnim.instance.pieceToState["legs"];
-
   bool playCrouchWalkAudio = false;
 
   if (player.grounded && legInfo.label == "crouch-walk") {
@@ -1526,7 +1496,7 @@ void plugin::entity::UpdatePlayer(
   }
 
   if (
-      !player.prevGrounded && frameStartGrounded
+      !player.prevGrounded && events.startGrounded
    && player.prevAirVelocity > 1.0f
   ) {
     pul::audio::EventInfo audioEvent;
@@ -1542,6 +1512,28 @@ void plugin::entity::UpdatePlayer(
   playerOrigin -= glm::vec2(0.0f, 28.0f);
 }
 
+void plugin::entity::PredictPlayerMovement(
+  pul::core::SceneBundle & scene
+, pul::controls::Controller const & controls
+, pul::core::ComponentPlayer & player
+, glm::vec2 & playerOrigin
+, pul::core::ComponentHitboxAABB & hitbox
+, pul::animation::ComponentInstance const & playerAnim
+) {
+  playerOrigin += glm::vec2(0.0f, 28.0f);
+
+  auto const * legs =
+    playerAnim.instance.pieceToState.Find(pul::animation::PieceId::Legs);
+
+  ::UpdatePlayerMovement(
+    scene, controls, player, playerOrigin, hitbox
+  , legs && legs->animationFinished
+  , nullptr
+  );
+
+  playerOrigin -= glm::vec2(0.0f, 28.0f);
+}
+
 void plugin::entity::DebugUiDispatchPlayer(
   pul::core::SceneBundle & scene
 , pul::core::ComponentPlayer & player
@@ -30,6 +30,14 @@ namespace {
 struct ComponentZeusStingerSecondary {};
 struct ComponentBadFetusSecondary {};
 
+// how far back the hitboxes are rewound for the hitscan of a player, only
+// players controlled over the network are behind the server
+float ShooterRewindMs(entt::registry const & registry, entt::entity player) {
+  auto const * networkControllable =
+    registry.try_get<pul::core::ComponentNetworkControllable>(player);
+  return networkControllable ? networkControllable->rewindMs : 0.0f;
+}
+
 void CreateBadFetusLinkedBeam(
   pul::core::SceneBundle & scene
 , pul::core::ComponentPlayer & player
@@ -44,7 +52,7 @@ void CreateBadFetusLinkedBeam(
   auto origin = playerOrigin + glm::vec2(0, 28.0f);
 
   auto const & weaponState =
-    playerAnim.pieceToState["weapon-placeholder"];
+    playerAnim.pieceToState[pul::animation::PieceId::WeaponPlaceholder];
   auto const & weaponMatrix = weaponState.cachedLocalSkeletalMatrix;
 
   namespace config = plugin::config::badFetus::combo;
@@ -59,7 +67,7 @@ void CreateBadFetusLinkedBeam(
     plugin::animation::ConstructInstance(
       scene, instance, scene.AnimationSystem(), "bad-fetus-link-muzzle-flash"
     );
-    auto & state = instance.pieceToState["particle"];
+    auto & state = instance.pieceToState[pul::animation::PieceId::Particle];
     state.Apply("bad-fetus-link-muzzle-flash", true);
     state.angle = player.lookAtAngle;
     state.flip = weaponState.flip;
@@ -85,7 +93,7 @@ void CreateBadFetusLinkedBeam(
       scene, instance, scene.AnimationSystem()
     , "bad-fetus-linked-ball-projectile"
     );
-    auto & state = instance.pieceToState["particle"];
+    auto & state = instance.pieceToState[pul::animation::PieceId::Particle];
     state.Apply("bad-fetus-linked-ball-projectile", true);
     state.angle = 0.0f;
     state.flip = false;
@@ -106,7 +114,7 @@ void CreateBadFetusLinkedBeam(
       scene, instance, scene.AnimationSystem()
     , "bad-fetus-link-beam"
     );
-    auto & state = instance.pieceToState["particle"];
+    auto & state = instance.pieceToState[pul::animation::PieceId::Particle];
     state.Apply("bad-fetus-link-beam", true);
     instance.origin = playerOrigin + glm::vec2(0.0f, 28.0f);
     state.flip = weaponState.flip;
@@ -155,7 +163,8 @@ void CreateBadFetusLinkedBeam(
                 scene, instance, scene.AnimationSystem()
               , "bad-fetus-linked-ball-projectile"
               );
-              auto & state = instance.pieceToState["particle"];
+              auto & state =
+                instance.pieceToState[pul::animation::PieceId::Particle];
               state.Apply("bad-fetus-linked-ball-projectile", true);
               state.angle = 0.0f;
               state.flip = false;
@@ -177,7 +186,7 @@ void CreateBadFetusLinkedBeam(
 
                 particleGrenade
                   .animationInstance
-                  .pieceToState["particle"]
+                  .pieceToState[pul::animation::PieceId::Particle]
                   .Apply("bad-fetus-explosion", true);
 
                 particleGrenade.origin = animComponent.instance.origin;
@@ -213,13 +222,15 @@ void CreateBadFetusLinkedBeam(
 
         // -- update animation origin/direction
         auto const & weaponStatePlaceholder =
-          playerAnim.pieceToState["weapon-placeholder"];
+          playerAnim.pieceToState[pul::animation::PieceId::WeaponPlaceholder];
 
-        bool const weaponFlip = playerAnim.pieceToState["legs"].flip;
+        bool const weaponFlip =
+          playerAnim.pieceToState[pul::animation::PieceId::Legs].flip;
 
         animInstance.origin = playerOrigin + glm::vec2(0.0f, 28.0f);
 
-        auto & animState = animInstance.pieceToState["particle"];
+        auto & animState =
+          animInstance.pieceToState[pul::animation::PieceId::Particle];
         animState.flip = weaponFlip;
 
         auto const & weaponMatrixPlaceholder =
@@ -345,7 +356,7 @@ void GrannibalMuzzleTrail(
   plugin::animation::ConstructInstance(
     scene, instance, scene.AnimationSystem(), "grannibal-fire"
   );
-  auto & state = instance.pieceToState["particle"];
+  auto & state = instance.pieceToState[pul::animation::PieceId::Particle];
   state.Apply("grannibal-fire", true);
   state.angle = 0.0f;
   state.flip = flip;
@@ -395,13 +406,13 @@ void plugin::entity::PlayerFireVolnias(
   // apply cooldown
   if (!primary || forceCooldown) {
     volInfo.primaryChargeupTimer =
-      glm::max(0.0f, volInfo.primaryChargeupTimer - pul::util::MsPerFrame*2.0f);
+      glm::max(0.0f, volInfo.primaryChargeupTimer - scene.clock.tickMs*2.0f);
     volInfo.hasChargedPrimary = false;
   }
 
   // apply primary shooting
   if (primary && !forceCooldown) {
-    volInfo.primaryChargeupTimer += pul::util::MsPerFrame;
+    volInfo.primaryChargeupTimer += scene.clock.tickMs;
     if (
         !volInfo.hasChargedPrimary
      && volInfo.primaryChargeupTimer >= config::ChargeupPreBeginThreshold()
@@ -422,7 +433,7 @@ void plugin::entity::PlayerFireVolnias(
   // apply secondary chargeup
   if (secondary && !forceCooldown) {
     if (volInfo.secondaryChargedShots < configSec::MaxChargedShots()) {
-      volInfo.secondaryChargeupTimer += pul::util::MsPerFrame;
+      volInfo.secondaryChargeupTimer += scene.clock.tickMs;
       if (volInfo.secondaryChargeupTimer >= configSec::ChargeupDelta()) {
         volInfo.secondaryChargeupTimer -= configSec::ChargeupDelta();
         audioSystem.volniasChargePrimary = true;
@@ -435,7 +446,7 @@ void plugin::entity::PlayerFireVolnias(
     } else {
       // check if we have to force shoot
 
-      volInfo.secondaryChargeupTimer += pul::util::MsPerFrame;
+      volInfo.secondaryChargeupTimer += scene.clock.tickMs;
       if (
           !volInfo.overchargedSecondary
        && volInfo.secondaryChargeupTimer
@@ -461,7 +472,7 @@ void plugin::entity::PlayerFireVolnias(
       }
       volInfo.dischargingSecondary = true;
 
-      volInfo.dischargingTimer += pul::util::MsPerFrame;
+      volInfo.dischargingTimer += scene.clock.tickMs;
       if (volInfo.dischargingTimer > configSec::DischargeDelta()) {
         volInfo.dischargingTimer -= configSec::DischargeDelta();
         plugin::entity::FireVolniasSecondary(
@@ -503,7 +514,7 @@ void plugin::entity::FireVolniasPrimary(
     plugin::animation::ConstructInstance(
       scene, instance, scene.AnimationSystem(), "volnias-fire"
     );
-    auto & state = instance.pieceToState["particle"];
+    auto & state = instance.pieceToState[pul::animation::PieceId::Particle];
     state.Apply("volnias-fire", true);
     state.angle = angle;
     state.flip = flip;
@@ -524,7 +535,7 @@ void plugin::entity::FireVolniasPrimary(
     plugin::animation::ConstructInstance(
       scene, instance, scene.AnimationSystem(), "volnias-projectile"
     );
-    auto & state = instance.pieceToState["particle"];
+    auto & state = instance.pieceToState[pul::animation::PieceId::Particle];
     state.Apply("volnias-projectile", true);
     state.angle = angle;
     state.flip = flip;
@@ -558,7 +569,8 @@ void plugin::entity::FireVolniasPrimary(
 
     exploder
       .animationInstance
-      .pieceToState["particle"].Apply("volnias-hit", true);
+      .pieceToState[pul::animation::PieceId::Particle]
+      .Apply("volnias-hit", true);
 
     exploder.audioTrigger = &scene.AudioSystem().volniasHit;
 
@@ -620,11 +632,11 @@ void plugin::entity::PlayerFireGrannibal(
       -- grannibalInfo.primaryMuzzleTrailLeft;
       grannibalInfo.primaryMuzzleTrailTimer = config::MuzzleTrailTimer();
     }
-    grannibalInfo.primaryMuzzleTrailTimer -= pul::util::MsPerFrame;
+    grannibalInfo.primaryMuzzleTrailTimer -= scene.clock.tickMs;
   }
 
   if (grannibalInfo.dischargingTimer > 0.0f) {
-    grannibalInfo.dischargingTimer -= pul::util::MsPerFrame;
+    grannibalInfo.dischargingTimer -= scene.clock.tickMs;
     return;
   }
 
@@ -670,7 +682,7 @@ void plugin::entity::FireGrannibalPrimary(
     plugin::animation::ConstructInstance(
       scene, instance, scene.AnimationSystem(), "grannibal-projectile"
     );
-    auto & state = instance.pieceToState["particle"];
+    auto & state = instance.pieceToState[pul::animation::PieceId::Particle];
     state.Apply("grannibal-projectile", true);
     state.angle = angle;
     state.flip = flip;
@@ -689,7 +701,7 @@ void plugin::entity::FireGrannibalPrimary(
 
       emitter
         .animationInstance
-        .pieceToState["particle"]
+        .pieceToState[pul::animation::PieceId::Particle]
         .Apply("grannibal-primary-projectile-trail", true);
 
       // -- timer
@@ -728,7 +740,8 @@ void plugin::entity::FireGrannibalPrimary(
 
     exploder
       .animationInstance
-      .pieceToState["particle"].Apply("grannibal-hit", true);
+      .pieceToState[pul::animation::PieceId::Particle]
+      .Apply("grannibal-hit", true);
 
     registry.emplace<pul::core::ComponentParticleExploder>(
       grannibalProjectileEntity, std::move(exploder)
@@ -757,7 +770,7 @@ void plugin::entity::FireGrannibalSecondary(
     plugin::animation::ConstructInstance(
       scene, instance, scene.AnimationSystem(), "grannibal-secondary-projectile"
     );
-    auto & state = instance.pieceToState["particle"];
+    auto & state = instance.pieceToState[pul::animation::PieceId::Particle];
     state.Apply("grannibal-secondary-projectile", true);
     state.angle = angle;
     state.flip = flip;
@@ -775,7 +788,7 @@ void plugin::entity::FireGrannibalSecondary(
 
       emitter
         .animationInstance
-        .pieceToState["particle"]
+        .pieceToState[pul::animation::PieceId::Particle]
         .Apply("grannibal-secondary-projectile-trail", true);
 
       // -- timer
@@ -807,7 +820,8 @@ void plugin::entity::FireGrannibalSecondary(
 
     particle
       .animationInstance
-      .pieceToState["particle"].Apply("grannibal-hit", true);
+      .pieceToState[pul::animation::PieceId::Particle]
+      .Apply("grannibal-hit", true);
 
     particle.origin = instance.origin;
     particle.velocity = direction*config::ProjectileVelocity();
@@ -840,7 +854,7 @@ void plugin::entity::PlayerFireDopplerBeam(
   namespace configSec = plugin::config::dopplerBeam::secondary;
 
   if (dopplerBeamInfo.dischargingTimer > 0.0f) {
-    dopplerBeamInfo.dischargingTimer -= pul::util::MsPerFrame;
+    dopplerBeamInfo.dischargingTimer -= scene.clock.tickMs;
     return;
   }
 
@@ -882,7 +896,7 @@ void plugin::entity::FireDopplerBeamPrimary(
     plugin::animation::ConstructInstance(
       scene, instance, scene.AnimationSystem(), "doppler-beam-fire"
     );
-    auto & state = instance.pieceToState["particle"];
+    auto & state = instance.pieceToState[pul::animation::PieceId::Particle];
     state.Apply("doppler-beam-fire", true);
     state.angle = angle;
     state.flip = flip;
@@ -903,7 +917,7 @@ void plugin::entity::FireDopplerBeamPrimary(
     plugin::animation::ConstructInstance(
       scene, instance, scene.AnimationSystem(), "doppler-beam-projectile"
     );
-    auto & state = instance.pieceToState["particle"];
+    auto & state = instance.pieceToState[pul::animation::PieceId::Particle];
     state.Apply("doppler-beam-projectile", true);
     state.angle = angle;
     state.flip = flip;
@@ -930,7 +944,7 @@ void plugin::entity::FireDopplerBeamPrimary(
 
       emitter
         .animationInstance
-        .pieceToState["particle"]
+        .pieceToState[pul::animation::PieceId::Particle]
         .Apply("doppler-beam-projectile-trail", true);
 
       // -- timer
@@ -960,7 +974,8 @@ void plugin::entity::FireDopplerBeamPrimary(
 
     exploder
       .animationInstance
-      .pieceToState["particle"].Apply("doppler-beam-hit", true);
+      .pieceToState[pul::animation::PieceId::Particle]
+      .Apply("doppler-beam-hit", true);
 
     registry.emplace<pul::core::ComponentParticleExploder>(
       dopplerBeamProjectileEntity, std::move(exploder)
@@ -1008,7 +1023,7 @@ void plugin::entity::PlayerFirePericaliya(
   namespace configSec = plugin::config::pericaliya::secondary;
 
   if (pericaliyaInfo.dischargingTimer > 0.0f) {
-    pericaliyaInfo.dischargingTimer -= pul::util::MsPerFrame;
+    pericaliyaInfo.dischargingTimer -= scene.clock.tickMs;
     return;
   }
 
@@ -1069,7 +1084,7 @@ void plugin::entity::FirePericaliyaPrimary(
     plugin::animation::ConstructInstance(
       scene, instance, scene.AnimationSystem(), "pericaliya-muzzle"
     );
-    auto & state = instance.pieceToState["particle"];
+    auto & state = instance.pieceToState[pul::animation::PieceId::Particle];
     state.Apply("pericaliya-muzzle", true);
     state.angle = angle;
     state.flip = flip;
@@ -1090,7 +1105,7 @@ void plugin::entity::FirePericaliyaPrimary(
     plugin::animation::ConstructInstance(
       scene, instance, scene.AnimationSystem(), "pericaliya-primary-projectile"
     );
-    auto & state = instance.pieceToState["particle"];
+    auto & state = instance.pieceToState[pul::animation::PieceId::Particle];
     state.Apply("pericaliya-primary-projectile", true);
     state.angle = angle;
     state.flip = flip;
@@ -1108,7 +1123,7 @@ void plugin::entity::FirePericaliyaPrimary(
 
       emitter
         .animationInstance
-        .pieceToState["particle"]
+        .pieceToState[pul::animation::PieceId::Particle]
         .Apply("pericaliya-primary-projectile-trail", true);
 
       // -- timer
@@ -1161,7 +1176,8 @@ void plugin::entity::FirePericaliyaPrimary(
 
     exploder
       .animationInstance
-      .pieceToState["particle"].Apply("pericaliya-primary-explosion", true);
+      .pieceToState[pul::animation::PieceId::Particle]
+      .Apply("pericaliya-primary-explosion", true);
 
     registry.emplace<pul::core::ComponentParticleExploder>(
       pericaliyaProjectileEntity, std::move(exploder)
@@ -1198,7 +1214,7 @@ void plugin::entity::FirePericaliyaSecondary(
       plugin::animation::ConstructInstance(
         scene, instance, scene.AnimationSystem(), "pericaliya-muzzle"
       );
-      auto & state = instance.pieceToState["particle"];
+      auto & state = instance.pieceToState[pul::animation::PieceId::Particle];
       state.Apply("pericaliya-muzzle", true);
       state.angle = fireAngle;
       state.flip = flip;
@@ -1220,7 +1236,7 @@ void plugin::entity::FirePericaliyaSecondary(
         scene, instance, scene.AnimationSystem()
       , "pericaliya-secondary-projectile"
       );
-      auto & state = instance.pieceToState["particle"];
+      auto & state = instance.pieceToState[pul::animation::PieceId::Particle];
       state.Apply("pericaliya-secondary-projectile", true);
       state.angle = fireAngle;
       state.flip = flip;
@@ -1238,7 +1254,7 @@ void plugin::entity::FirePericaliyaSecondary(
 
         emitter
           .animationInstance
-          .pieceToState["particle"]
+          .pieceToState[pul::animation::PieceId::Particle]
           .Apply("pericaliya-secondary-projectile-trail", true);
 
         // -- timer
@@ -1263,7 +1279,7 @@ void plugin::entity::FirePericaliyaSecondary(
       , [
           &pericaliyaInfo, hasBeenActive, fireAngle, localFireAngle, activeTimer
         ](
-          glm::vec2 & velocity
+          glm::vec2 & velocity, float const msElapsed
         ) mutable -> void {
           // check when no longer shooting
           if (!hasBeenActive && !pericaliyaInfo.isSecondaryActive) {
@@ -1283,7 +1299,7 @@ void plugin::entity::FirePericaliyaSecondary(
             // TODO add the ring thing
           }
 
-          activeTimer += pul::util::MsPerFrame;
+          activeTimer += msElapsed;
         }
       );
 
@@ -1304,7 +1320,8 @@ void plugin::entity::FirePericaliyaSecondary(
 
       exploder
         .animationInstance
-        .pieceToState["particle"].Apply("pericaliya-secondary-explosion", true);
+        .pieceToState[pul::animation::PieceId::Particle]
+        .Apply("pericaliya-secondary-explosion", true);
 
       registry.emplace<pul::core::ComponentParticleExploder>(
         pericaliyaProjectileEntity, std::move(exploder)
@@ -1333,7 +1350,7 @@ void plugin::entity::PlayerFireZeusStinger(
   namespace configSec = plugin::config::zeusStinger::secondary;
 
   if (zeusStingerInfo.dischargingTimer > 0.0f) {
-    zeusStingerInfo.dischargingTimer -= pul::util::MsPerFrame;
+    zeusStingerInfo.dischargingTimer -= scene.clock.tickMs;
     return;
   }
 
@@ -1375,7 +1392,8 @@ void plugin::entity::FireZeusStingerPrimary(
       scene, animInstance, scene.AnimationSystem()
     , "zeus-stinger-primary-beam-muzzle-flash"
     );
-    auto & animState = animInstance.pieceToState["particle"];
+    auto & animState =
+      animInstance.pieceToState[pul::animation::PieceId::Particle];
     animState.Apply("zeus-stinger-primary-beam-muzzle-flash", true);
     animState.flip = flip;
     animInstance.origin = origin + glm::vec2(0.0f, 32.0f);
@@ -1412,7 +1430,8 @@ void plugin::entity::FireZeusStingerPrimary(
         scene, animInstance, scene.AnimationSystem()
       , "zeus-stinger-primary-beam"
       );
-      auto & animState = animInstance.pieceToState["particle"];
+      auto & animState =
+        animInstance.pieceToState[pul::animation::PieceId::Particle];
       animState.Apply("zeus-stinger-primary-beam", true);
 
       // -- update animation origin/direction
@@ -1525,6 +1544,7 @@ void plugin::entity::FireZeusStingerPrimary(
       , config::ProjectileDamage()
       , config::ProjectileForce()
       , playerEntity // ignored player
+      , ::ShooterRewindMs(registry, playerEntity)
       )
     ;
 
@@ -1553,7 +1573,8 @@ void plugin::entity::FireZeusStingerPrimary(
         pul::animation::ComponentInstance
       >(zeusStingerBeamEntity).instance
     ;
-    auto & animState = animInstance.pieceToState["particle"];
+    auto & animState =
+      animInstance.pieceToState[pul::animation::PieceId::Particle];
 
     // -- apply clipping
     float clipLength =
@@ -1577,7 +1598,8 @@ void plugin::entity::FireZeusStingerPrimary(
           pul::animation::ComponentInstance
         >(zeusStingerMuzzleEntity).instance
       ;
-      auto & muzzleAnimState = muzzleAnimInstance.pieceToState["particle"];
+      auto & muzzleAnimState =
+        muzzleAnimInstance.pieceToState[pul::animation::PieceId::Particle];
 
       // TODO don't hardcode
       muzzleAnimState.uvCoordWrap.x = clipLength / 128.0f;
@@ -1601,7 +1623,7 @@ void plugin::entity::FireZeusStingerPrimary(
       plugin::animation::ConstructInstance(
         scene, instance, scene.AnimationSystem(), explosionStr
       );
-      auto & state = instance.pieceToState["particle"];
+      auto & state = instance.pieceToState[pul::animation::PieceId::Particle];
       state.Apply(explosionStr, true);
       state.angle = 0.0f;
       state.flip = flip;
@@ -1624,7 +1646,8 @@ void plugin::entity::FireZeusStingerPrimary(
         scene, animInstance, scene.AnimationSystem()
       , "zeus-stinger-scatter-beam"
       );
-      auto & animState = animInstance.pieceToState["particle"];
+      auto & animState =
+        animInstance.pieceToState[pul::animation::PieceId::Particle];
       animState.Apply("zeus-stinger-scatter-beam", true);
 
       // -- update animation origin/direction
@@ -1696,7 +1719,7 @@ void plugin::entity::FireZeusStingerSecondary(
         scene, instance, scene.AnimationSystem()
       , "zeus-stinger-secondary-projectile"
       );
-      auto & state = instance.pieceToState["particle"];
+      auto & state = instance.pieceToState[pul::animation::PieceId::Particle];
       state.Apply("zeus-stinger-secondary-projectile", true);
       state.angle = angle;
       state.flip = flip;
@@ -1724,7 +1747,7 @@ void plugin::entity::FireZeusStingerSecondary(
 
       particle
         .animationInstance
-        .pieceToState["particle"]
+        .pieceToState[pul::animation::PieceId::Particle]
         .Apply("zeus-stinger-secondary-explosion", true);
 
       particle.origin = instance.origin;
@@ -1763,7 +1786,7 @@ void plugin::entity::PlayerFireBadFetus(
   namespace configSec = plugin::config::badFetus::secondary;
 
   if (badFetusInfo.dischargingTimer > 0.0f) {
-    badFetusInfo.dischargingTimer -= pul::util::MsPerFrame;
+    badFetusInfo.dischargingTimer -= scene.clock.tickMs;
     return;
   }
 
@@ -1816,7 +1839,7 @@ void plugin::entity::FireBadFetusPrimary(
     plugin::animation::ConstructInstance(
       scene, instance, scene.AnimationSystem(), "bad-fetus-primary-muzzle-flash"
     );
-    auto & state = instance.pieceToState["particle"];
+    auto & state = instance.pieceToState[pul::animation::PieceId::Particle];
     state.Apply("bad-fetus-primary-muzzle-flash", true);
     state.angle = angle;
     state.flip = flip;
@@ -1840,7 +1863,7 @@ void plugin::entity::FireBadFetusPrimary(
       scene, instance, scene.AnimationSystem()
     , "bad-fetus-primary-beam"
     );
-    auto & state = instance.pieceToState["particle"];
+    auto & state = instance.pieceToState[pul::animation::PieceId::Particle];
     state.Apply("bad-fetus-primary-beam", true);
     instance.origin = origin;
     state.flip = flip;
@@ -1877,13 +1900,15 @@ void plugin::entity::FireBadFetusPrimary(
         // -- update animation origin/direction
         auto const & weaponState =
           playerAnim
-            .pieceToState["weapon-placeholder"];
+            .pieceToState[pul::animation::PieceId::WeaponPlaceholder];
 
-        bool const weaponFlip = playerAnim.pieceToState["legs"].flip;
+        bool const weaponFlip =
+          playerAnim.pieceToState[pul::animation::PieceId::Legs].flip;
 
         animInstance.origin = playerOrigin + glm::vec2(0.0f, 32.0f);
 
-        auto & animState = animInstance.pieceToState["particle"];
+        auto & animState =
+          animInstance.pieceToState[pul::animation::PieceId::Particle];
         animState.flip = weaponFlip;
 
         auto const & weaponMatrix = weaponState.cachedLocalSkeletalMatrix;
@@ -1936,6 +1961,7 @@ void plugin::entity::FireBadFetusPrimary(
           , weaponCooldown <= 0.0f ? config::ProjectileDamage() : 0.0f
           , config::ProjectileForce() // force
           , playerEntity // ignored player
+          , ::ShooterRewindMs(registry, playerEntity)
           )
         ;
 
@@ -1950,7 +1976,7 @@ void plugin::entity::FireBadFetusPrimary(
           }
         }
 
-        weaponCooldown -= pul::util::MsPerFrame;
+        weaponCooldown -= scene.clock.tickMs;
 
         if (hasHit) {
           // apply clipping
@@ -1975,7 +2001,8 @@ void plugin::entity::FireBadFetusPrimary(
               scene, instance, scene.AnimationSystem()
             , "bad-fetus-primary-hit-trail"
             );
-            auto & state = instance.pieceToState["particle"];
+            auto & state =
+              instance.pieceToState[pul::animation::PieceId::Particle];
             state.Apply("bad-fetus-primary-hit-trail", true);
 
             // origin is where we collided but a few pixels towards player
@@ -2070,7 +2097,7 @@ void plugin::entity::FireBadFetusSecondary(
     plugin::animation::ConstructInstance(
       scene, instance, scene.AnimationSystem(), "bad-fetus-primary-muzzle-flash"
     );
-    auto & state = instance.pieceToState["particle"];
+    auto & state = instance.pieceToState[pul::animation::PieceId::Particle];
     state.Apply("bad-fetus-primary-muzzle-flash", true);
     state.angle = angle;
     state.flip = flip;
@@ -2097,7 +2124,7 @@ void plugin::entity::FireBadFetusSecondary(
       scene, instance, scene.AnimationSystem()
     , "bad-fetus-secondary-projectile"
     );
-    auto & state = instance.pieceToState["particle"];
+    auto & state = instance.pieceToState[pul::animation::PieceId::Particle];
     state.Apply("bad-fetus-secondary-projectile", true);
     state.angle = angle;
     state.flip = flip;
@@ -2124,7 +2151,7 @@ void plugin::entity::FireBadFetusSecondary(
 
       particle
         .animationInstance
-        .pieceToState["particle"]
+        .pieceToState[pul::animation::PieceId::Particle]
         .Apply("bad-fetus-explosion", true);
 
       particle.origin = instance.origin;
@@ -2151,7 +2178,7 @@ void plugin::entity::FireBadFetusSecondary(
 
       emitter
         .animationInstance
-        .pieceToState["particle"]
+        .pieceToState[pul::animation::PieceId::Particle]
         .Apply("bad-fetus-secondary-projectile-trail", true);
 
       // -- timer
@@ -2243,7 +2270,7 @@ void plugin::entity::PlayerFireManshredder(
   namespace configSec = plugin::config::manshredder::secondary;
 
   if (manshredderInfo.dischargingTimer > 0.0f) {
-    manshredderInfo.dischargingTimer -= pul::util::MsPerFrame;
+    manshredderInfo.dischargingTimer -= scene.clock.tickMs;
     return;
   }
 
@@ -2300,7 +2327,7 @@ void plugin::entity::FireManshredderPrimary(
       plugin::animation::ConstructInstance(
         scene, instance, scene.AnimationSystem(), "manshredder-primary-fire"
       );
-      auto & state = instance.pieceToState["particle"];
+      auto & state = instance.pieceToState[pul::animation::PieceId::Particle];
       state.Apply("manshredder-primary-fire", true);
       state.angle = angle;
       state.flip = flip;
@@ -2331,7 +2358,8 @@ void plugin::entity::FireManshredderPrimary(
           registry.get<pul::animation::ComponentInstance>(
             manshredderProjectileEntity
           ).instance;
-        auto & state = animation.pieceToState.at("particle");
+        auto & state =
+          animation.pieceToState[pul::animation::PieceId::Particle];
 
         { // update origin/animation
           animation.origin = playerOrigin + glm::vec2(0.0f, 28.0f);
@@ -2370,6 +2398,7 @@ void plugin::entity::FireManshredderPrimary(
             , config::ProjectileDamage()
             , config::ProjectileForce()
             , playerEntity // ignored player
+            , ::ShooterRewindMs(registry, playerEntity)
             ).entity != entt::null
           ;
 
@@ -2410,7 +2439,7 @@ void plugin::entity::FireManshredderSecondary(
     plugin::animation::ConstructInstance(
       scene, instance, scene.AnimationSystem(), "manshredder-secondary-fire"
     );
-    auto & state = instance.pieceToState["particle"];
+    auto & state = instance.pieceToState[pul::animation::PieceId::Particle];
     state.Apply("manshredder-secondary-fire", true);
     state.angle = angle;
     state.flip = flip;
@@ -2432,7 +2461,7 @@ void plugin::entity::FireManshredderSecondary(
       scene, instance, scene.AnimationSystem()
     , "manshredder-secondary-projectile"
     );
-    auto & state = instance.pieceToState["particle"];
+    auto & state = instance.pieceToState[pul::animation::PieceId::Particle];
     state.Apply("manshredder-secondary-projectile", true);
     state.angle = angle;
     state.flip = flip;
@@ -2450,7 +2479,7 @@ void plugin::entity::FireManshredderSecondary(
 
       emitter
         .animationInstance
-        .pieceToState["particle"]
+        .pieceToState[pul::animation::PieceId::Particle]
         .Apply("manshredder-secondary-projectile", true);
 
       // -- timer
@@ -2491,7 +2520,8 @@ void plugin::entity::FireManshredderSecondary(
 
     exploder
       .animationInstance
-      .pieceToState["particle"].Apply("manshredder-secondary-hit", true);
+      .pieceToState[pul::animation::PieceId::Particle]
+      .Apply("manshredder-secondary-hit", true);
 
     registry.emplace<pul::core::ComponentParticleExploder>(
       manshredderProjectileEntity, std::move(exploder)
@@ -2517,7 +2547,7 @@ void plugin::entity::PlayerFireWallbanger(
   namespace configSec = plugin::config::wallbanger::secondary;
 
   if (wallbangerInfo.dischargingTimer > 0.0f) {
-    wallbangerInfo.dischargingTimer -= pul::util::MsPerFrame;
+    wallbangerInfo.dischargingTimer -= scene.clock.tickMs;
     return;
   }
 
@@ -2559,7 +2589,7 @@ void plugin::entity::FireWallbangerPrimary(
     plugin::animation::ConstructInstance(
       scene, instance, scene.AnimationSystem(), "wallbanger-primary-muzzle"
     );
-    auto & state = instance.pieceToState["particle"];
+    auto & state = instance.pieceToState[pul::animation::PieceId::Particle];
     state.Apply("wallbanger-primary-muzzle", true);
     state.angle = angle;
     state.flip = flip;
@@ -2581,7 +2611,7 @@ void plugin::entity::FireWallbangerPrimary(
       scene, instance, scene.AnimationSystem()
     , "wallbanger-primary-projectile"
     );
-    auto & state = instance.pieceToState["particle"];
+    auto & state = instance.pieceToState[pul::animation::PieceId::Particle];
     state.Apply("wallbanger-primary-projectile", true);
     state.angle = angle;
     state.flip = flip;
@@ -2608,7 +2638,7 @@ void plugin::entity::FireWallbangerPrimary(
 
       particle
         .animationInstance
-        .pieceToState["particle"]
+        .pieceToState[pul::animation::PieceId::Particle]
         .Apply("wallbanger-primary-explosion", true);
 
       particle.origin = instance.origin;
@@ -2648,7 +2678,7 @@ void plugin::entity::FireWallbangerSecondary(
       scene, instance, scene.AnimationSystem()
     , "wallbanger-secondary-muzzle-big"
     );
-    auto & state = instance.pieceToState["particle"];
+    auto & state = instance.pieceToState[pul::animation::PieceId::Particle];
     state.Apply("wallbanger-secondary-muzzle-big", true);
     state.angle = angle;
     state.flip = flip;
@@ -2674,7 +2704,7 @@ void plugin::entity::FireWallbangerSecondary(
       scene, instance, scene.AnimationSystem()
     , "wallbanger-secondary-muzzle-small"
     );
-    auto & state = instance.pieceToState["particle"];
+    auto & state = instance.pieceToState[pul::animation::PieceId::Particle];
     state.Apply("wallbanger-secondary-muzzle-small", true);
     state.angle = angle;
     state.flip = flip;
@@ -2744,7 +2774,7 @@ void plugin::entity::FireWallbangerSecondary(
     plugin::animation::ConstructInstance(
       scene, instance, scene.AnimationSystem(), "wallbanger-wall-muzzle"
     );
-    auto & state = instance.pieceToState["particle"];
+    auto & state = instance.pieceToState[pul::animation::PieceId::Particle];
     state.Apply("wallbanger-wall-muzzle", true);
     state.angle = angle;
     state.flip = flip;
@@ -2763,7 +2793,8 @@ void plugin::entity::FireWallbangerSecondary(
         scene, animInstance, scene.AnimationSystem()
       , "wallbanger-secondary-wall-beam"
       );
-      auto & animState = animInstance.pieceToState["particle"];
+      auto & animState =
+        animInstance.pieceToState[pul::animation::PieceId::Particle];
       animState.Apply("wallbanger-secondary-wall-beam", true);
 
       // -- update animation origin/direction
@@ -2798,7 +2829,8 @@ void plugin::entity::FireWallbangerSecondary(
       pul::animation::ComponentInstance
     >(wallbangerBeamEntity).instance
   ;
-  auto & animState = animInstance.pieceToState["particle"];
+  auto & animState =
+    animInstance.pieceToState[pul::animation::PieceId::Particle];
 
   // -- apply clipping
   float clipLength =
@@ -2817,6 +2849,7 @@ void plugin::entity::FireWallbangerSecondary(
   , endOrigin, 128.0f
   , config::ProjectileDamage(), config::ProjectileForce()
   , entt::null
+  , ::ShooterRewindMs(registry, playerEntity)
   );
 
   { // explosion
@@ -2831,7 +2864,7 @@ void plugin::entity::FireWallbangerSecondary(
     plugin::animation::ConstructInstance(
       scene, instance, scene.AnimationSystem(), explosionStr
     );
-    auto & state = instance.pieceToState["particle"];
+    auto & state = instance.pieceToState[pul::animation::PieceId::Particle];
     state.Apply(explosionStr, true);
     state.angle = 0.0f;
     state.flip = flip;
@@ -2850,6 +2883,7 @@ plugin::entity::WeaponDamageRaycast(
 , glm::vec2 const & originBegin, glm::vec2 const & originEnd
 , float const damage, float const force
 , entt::entity ignoredEntity
+, float const rewindMs
 ) {
   auto & registry = scene.EnttRegistry();
 
@@ -2862,7 +2896,9 @@ plugin::entity::WeaponDamageRaycast(
 
   // iterate thru all entity intersections, and if damageable record
   // the damage
-  plugin::physics::EntityIntersectionRaycast(scene, ray, results);
+  plugin::physics::EntityIntersectionRaycastRewound(
+    scene, ray, rewindMs, results
+  );
   for (auto & entityIntersection : results.entities) {
     auto * damageable =
       registry.try_get<pul::core::ComponentDamageable>(
@@ -2891,11 +2927,56 @@ plugin::entity::WeaponDamageRaycast(
   return ri;
 }
 
+plugin::entity::WeaponDamageRaycastReturnInfo
+plugin::entity::WeaponDamageSweep(
+  pul::core::SceneBundle & scene
+, glm::vec2 const & origin, glm::vec2 const & velocity
+, float const damage, float const force
+, entt::entity ignoredEntity
+, float const tickBegin, float const tickEnd
+) {
+  auto & registry = scene.EnttRegistry();
+
+  pul::physics::IntersectorSweptPoint sweep;
+  sweep.origin = origin;
+  sweep.velocity = velocity;
+  sweep.tickBegin = tickBegin;
+  sweep.tickEnd = tickEnd;
+  pul::physics::EntitySweptIntersectionResults results;
+
+  plugin::entity::WeaponDamageRaycastReturnInfo ri = {};
+
+  // record the damage of the earliest damageable entity hit
+  plugin::physics::EntityIntersectionSweptPoint(scene, sweep, results);
+  for (auto & contact : results.entities) {
+    auto * damageable =
+      registry.try_get<pul::core::ComponentDamageable>(contact.entity);
+    if (!damageable) { continue; }
+    if (contact.entity == ignoredEntity) { continue; }
+
+    pul::core::DamageInfo damageInfo;
+    damageInfo.directionForce =
+      velocity == glm::vec2(0.0f)
+    ? glm::vec2(0.0f) : glm::normalize(velocity) * force;
+    damageInfo.damage = damage;
+
+    damageable->frameDamageInfos.emplace_back(damageInfo);
+
+    ri.entity = contact.entity;
+    ri.origin = contact.origin;
+
+    break;
+  }
+
+  return ri;
+}
+
 bool plugin::entity::WeaponDamageCircle(
   pul::core::SceneBundle & scene
 , glm::vec2 const & origin, float radius
 , float const damage, float const force
 , entt::entity ignoredEntity
+, float const rewindMs
 ) {
   auto & registry = scene.EnttRegistry();
 
@@ -2906,7 +2987,9 @@ bool plugin::entity::WeaponDamageCircle(
 
   // iterate thru all entity intersections, and if damageable record
   // the damage
-  plugin::physics::EntityIntersectionCircle(scene, circle, results);
+  plugin::physics::EntityIntersectionCircleRewound(
+    scene, circle, rewindMs, results
+  );
   bool hasHit = false;
   for (auto & entityIntersection : results.entities) {
     auto * damageable =
@@ -13,18 +13,44 @@
 
 #include <glm/glm.hpp>
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 namespace {
 
 struct BaseRenderBundle {
-  InterpolantMap<plugin::animation::Interpolant> animationInterpolants;
+  plugin::animation::RenderSnapshot animationSnapshot;
+
+  static BaseRenderBundle * Allocate();
+  static void Deallocate(void * data);
+};
 
-  // only used as output TODO maybe make a different struct for outputs?
-  std::vector<plugin::animation::Interpolant> animationInterpolantOutputs;
+// a bundle is made every logic tick & render frame, bundles are recycled so
+// that their snapshot buffers keep the capacity they have grown to. Only the
+// previous, current & interpolated bundle are alive at once
+constexpr size_t maxPooledBundles = 4ul;
+std::vector<std::unique_ptr<BaseRenderBundle>> pooledBundles;
+
+BaseRenderBundle * BaseRenderBundle::Allocate() {
+  if (pooledBundles.empty()) { return new BaseRenderBundle; }
+
+  auto * bundle = pooledBundles.back().release();
+  pooledBundles.pop_back();
+  bundle->animationSnapshot.Clear();
+  return bundle;
+}
 
-  static void Deallocate(void * data) {
-    delete reinterpret_cast<BaseRenderBundle *>(data);
+void BaseRenderBundle::Deallocate(void * data) {
+  auto * bundle = reinterpret_cast<BaseRenderBundle *>(data);
+
+  if (pooledBundles.size() >= maxPooledBundles) {
+    delete bundle;
+    return;
   }
-};
+
+  pooledBundles.emplace_back(bundle);
+}
 
 }
 
@@ -36,7 +62,17 @@ PUL_PLUGIN_DECL void Plugin_UpdateRenderBundleInstance(
 ) {
   auto & registry = scene.EnttRegistry();
 
-  InterpolantMap<plugin::animation::Interpolant> animationInterpolants;
+  // -- retrieve the instance bundle to store data into
+  auto & instanceBundleDataAny = instance.pluginBundleData["base"];
+
+  if (!instanceBundleDataAny) {
+    instanceBundleDataAny = std::make_shared<pul::util::Any>();
+    instanceBundleDataAny->Deallocate = ::BaseRenderBundle::Deallocate;
+    instanceBundleDataAny->userdata = ::BaseRenderBundle::Allocate();
+  }
+
+  auto & instanceBundleData =
+    *reinterpret_cast<::BaseRenderBundle*>(instanceBundleDataAny->userdata);
 
   { // -- store animation information
 
@@ -48,6 +84,12 @@ PUL_PLUGIN_DECL void Plugin_UpdateRenderBundleInstance(
     , cullBoundDown  = cameraOrigin.y + scene.config.framebufferDimFloat.y/2.0f
     ;
 
+    // the snapshot is ordered by entity, so that interpolation can pair up
+    // the instances of two snapshots without a lookup
+    static std::vector<std::pair<size_t, pul::animation::Instance const *>>
+      visibleInstances;
+    visibleInstances.resize(0);
+
     auto view = registry.view<pul::animation::ComponentInstance>();
     for (auto entity : view) {
       auto & self = view.get<pul::animation::ComponentInstance>(entity);
@@ -68,36 +110,21 @@ PUL_PLUGIN_DECL void Plugin_UpdateRenderBundleInstance(
       // DEBUG
       /* debugRenderingInstances.emplace_back(&self.instance); */
 
-      // copy the entire instance
-      auto interpolantCopy = plugin::animation::Interpolant { self.instance };
-      auto & instanceCopy = interpolantCopy.instance;
-
-      // compute cache
-      plugin::animation::ComputeCache(
-        instanceCopy, instanceCopy.animator->skeleton
-      , glm::mat3(1.0f), false, 0.0f
-      );
-
-      // move instance w/ the entity ID
-      animationInterpolants.emplace(
-        static_cast<size_t>(entity), std::move(interpolantCopy)
+      visibleInstances.emplace_back(
+        static_cast<size_t>(entity), &self.instance
       );
     }
-  }
-
-  { // -- store data into the instance bundle
-    auto & instanceBundleDataAny = instance.pluginBundleData["base"];
-
-    if (!instanceBundleDataAny) {
-      instanceBundleDataAny = std::make_shared<pul::util::Any>();
-      instanceBundleDataAny->Deallocate = ::BaseRenderBundle::Deallocate;
-      instanceBundleDataAny->userdata = new ::BaseRenderBundle;
-    }
 
-    auto & instanceBundleData =
-      *reinterpret_cast<::BaseRenderBundle*>(instanceBundleDataAny->userdata);
+    std::sort(
+      visibleInstances.begin(), visibleInstances.end()
+    , [](auto const & a, auto const & b) { return a.first < b.first; }
+    );
 
-    instanceBundleData.animationInterpolants = std::move(animationInterpolants);
+    // the vertices were computed by this logic tick's animation update
+    auto & snapshot = instanceBundleData.animationSnapshot;
+    snapshot.Clear();
+    for (auto const & [entity, instancePtr] : visibleInstances)
+      { snapshot.Add(entity, *instancePtr); }
   }
 }
 
@@ -115,7 +142,7 @@ PUL_PLUGIN_DECL void Plugin_Interpolate(
   auto & bundleDataOutputAny = outputBundle.pluginBundleData["base"];
   bundleDataOutputAny = std::make_shared<pul::util::Any>();
   bundleDataOutputAny->Deallocate = ::BaseRenderBundle::Deallocate;
-  bundleDataOutputAny->userdata = new ::BaseRenderBundle;
+  bundleDataOutputAny->userdata = ::BaseRenderBundle::Allocate();
 
   // -- retrieve baserenderbundle for each
   auto
@@ -130,8 +157,8 @@ PUL_PLUGIN_DECL void Plugin_Interpolate(
   // -- forward rendering information
   plugin::animation::Interpolate(
     msDeltaInterp
-  , previous.animationInterpolants, current.animationInterpolants
-  , output.animationInterpolantOutputs
+  , previous.animationSnapshot, current.animationSnapshot
+  , output.animationSnapshot
   );
 }
 
@@ -154,7 +181,7 @@ PUL_PLUGIN_DECL void Plugin_RenderInterpolated(
   plugin::animation::RenderInterpolated(
     scene
   , interpolatedBundle
-  , current.animationInterpolantOutputs
+  , current.animationSnapshot
   );
 
   plugin::entity::RenderCursor(scene, interpolatedBundle);
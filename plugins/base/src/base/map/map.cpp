@@ -50,7 +50,7 @@ struct LayerRenderable {
 
   // kept in order to do CPU tilemap processing
   std::vector<size_t> tileIds;
-  std::vector<glm::u32vec2> tileOrigins;
+  std::vector<glm::i32vec2> tileOrigins;
   std::vector<pul::core::TileOrientation> tileOrientations;
 
   sg_buffer bufferVertex;
@@ -102,7 +102,7 @@ bool GetMapTileset(
 
 void MapSokolPushTile(
   std::string const & layer
-, uint32_t const x, uint32_t const y
+, int32_t const x, int32_t const y
 , bool const flipHorizontal
 , bool const flipVertical
 , bool const flipDiagonal
@@ -158,7 +158,7 @@ void MapSokolPushTile(
   , uvTileHeight = uvHeight / 32ul
   ;
 
-  renderable->tileOrigins.emplace_back(glm::u32vec2(x, y));
+  renderable->tileOrigins.emplace_back(glm::i32vec2(x, y));
   renderable->tileIds.emplace_back(localTileId);
   renderable->tileOrientations.emplace_back(
     static_cast<pul::core::TileOrientation>(
@@ -212,9 +212,17 @@ void MapSokolPushTile(
   }
 }
 
-void MapSokolEnd() {
+void MapSokolEnd(bool const headless) {
 
   for (auto & renderable : renderables) {
+    renderable.tileCount = renderable.origins.size();
+
+    if (headless) {
+      renderable.origins = {};
+      renderable.uvCoords = {};
+      continue;
+    }
+
     { // -- vertex origin buffer
       sg_buffer_desc desc = {};
       desc.size = renderable.origins.size() * sizeof(float) * 2;
@@ -238,13 +246,15 @@ void MapSokolEnd() {
     renderable.bindings.vertex_buffers[1] = renderable.bufferUvCoords;
     renderable.bindings.fs_images[0] =
       ::mapTilesets[renderable.spritesheetPrimaryIdx].spritesheet.Image();
-    renderable.tileCount = renderable.origins.size();
 
     // dealloc vectors if no longer needed
     renderable.origins = {};
     renderable.uvCoords = {};
   }
 
+  // tiles are only kept around for collision without a GPU context
+  if (headless) { return; }
+
   { // -- tilemap shader
     sg_shader_desc desc = {};
     desc.vs.uniform_blocks[0].size = sizeof(float) * 2;
@@ -373,13 +383,14 @@ void ParseLayerTile(
       , flipDiagonal   = gid & ::FlippedDiagonalGidFlag
       ;
 
-      size_t localX = localItr % width;
-      size_t localY = localItr / width;
+      // chunks of infinite maps can be placed at negative coordinates
+      auto const localX = static_cast<int32_t>(localItr % width);
+      auto const localY = static_cast<int32_t>(localItr / width);
 
       ::MapSokolPushTile(
         layerLabel
-      , static_cast<uint32_t>(x + localX)
-      , static_cast<uint32_t>(y + localY)
+      , x + localX
+      , y + localY
       , flipHorizontal, flipVertical, flipDiagonal
       , tileId
       );
@@ -541,10 +552,12 @@ void ParseLayerObject(pul::core::SceneBundle & scene , cJSON * layer) {
 
       pickupAnimationInstance.origin = origin;
       pickupAnimationInstance
-        .pieceToState["pickups"].Apply(animationStatePickupStr, true);
+        .pieceToState[pul::animation::PieceId::Pickups]
+        .Apply(animationStatePickupStr, true);
       if (applyPickupBg) {
         pickupAnimationInstance
-          .pieceToState["pickup-bg"].Apply(animationStatePickupStr, true);
+          .pieceToState[pul::animation::PieceId::PickupBg]
+          .Apply(animationStatePickupStr, true);
       }
 
       registry.emplace<pul::animation::ComponentInstance>(
@@ -657,7 +670,7 @@ void plugin::map::LoadMap(
       // emplace tileset w/ spritesheet and related tilemap info
       ::mapTilesets
         .emplace_back(MapTileset {
-            pul::gfx::Spritesheet::Construct(image)
+            pul::gfx::Spritesheet::Construct(image, !scene.config.headless)
           , std::move(physxTileset)
           , tilesJson
           , static_cast<size_t>(
@@ -685,13 +698,13 @@ void plugin::map::LoadMap(
 
   }
 
-  ::MapSokolEnd();
+  ::MapSokolEnd(scene.config.headless);
 
   { // create physics geometry for map
 
     std::vector<pul::physics::Tileset const *> tilesets;
     std::vector<std::span<size_t>> mapTileIndices;
-    std::vector<std::span<glm::u32vec2>> mapTileOrigins;
+    std::vector<std::span<glm::i32vec2>> mapTileOrigins;
     std::vector<std::span<pul::core::TileOrientation>> mapTileOrientations;
 
     for (auto & renderable : ::renderables) {
@@ -832,7 +845,7 @@ void plugin::map::DebugUiDispatch(pul::core::SceneBundle & scene) {
         }
 
         physxStr +=
-          physicsTile.signedDistanceField[i%32][i/32] > 0.0f ? "#" : "-";
+          ((physicsTile.collisionRows[i/32] >> (i%32)) & 1u) ? "#" : "-";
       }
 
       pul::imgui::Text("{}", physxStr);
@@ -861,19 +874,21 @@ void plugin::map::DebugUiDispatch(pul::core::SceneBundle & scene) {
   ImGui::End();
 }
 
-void plugin::map::Shutdown() {
+void plugin::map::Shutdown(pul::core::SceneBundle & scene) {
   spdlog::info("destroying map");
 
-  for (auto & renderable : ::renderables) {
-    sg_destroy_buffer(renderable.bufferVertex);
-    sg_destroy_buffer(renderable.bufferUvCoords);
+  if (!scene.config.headless) {
+    for (auto & renderable : ::renderables) {
+      sg_destroy_buffer(renderable.bufferVertex);
+      sg_destroy_buffer(renderable.bufferUvCoords);
+    }
+
+    sg_destroy_pipeline(::pipeline);
+    sg_destroy_shader(::shader);
   }
 
   ::renderables = {};
 
-  sg_destroy_pipeline(::pipeline);
-  sg_destroy_shader(::shader);
-
   ::pipeline = {};
   ::shader = {};
 
@@ -0,0 +1,290 @@
+#include <plugin-base/network/prediction.hpp>
+
+#include <plugin-base/entity/player.hpp>
+#include <plugin-base/network/replication.hpp>
+#include <plugin-base/physics/physics.hpp>
+
+#include <pulcher-animation/animation.hpp>
+#include <pulcher-controls/controls.hpp>
+#include <pulcher-core/enum.hpp>
+#include <pulcher-core/player.hpp>
+#include <pulcher-core/scene-bundle.hpp>
+#include <pulcher-network/shared.hpp>
+#include <pulcher-network/snapshot.hpp>
+#include <pulcher-util/enum.hpp>
+#include <pulcher-util/log.hpp>
+
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+
+#include <array>
+
+namespace {
+
+struct PredictedTick {
+  uint32_t tick = pul::network::PacketSnapshot::NoBaseline;
+  pul::controls::Controller::Frame input;
+  pul::core::ComponentPlayer player;
+  glm::vec2 origin;
+};
+
+// two seconds at the default tick rate, an input that has not been
+// acknowledged by then is not going to be
+std::array<PredictedTick, 128ul> predictions;
+
+uint32_t latestTick = pul::network::PacketSnapshot::NoBaseline;
+
+// floating point drift between the client & server that is not worth a
+// correction
+constexpr float mispredictionTolerance = 0.01f;
+
+using Button = pul::network::PacketPlayerInput::Button;
+
+PredictedTick * FindPrediction(uint32_t const tick) {
+  auto & prediction = ::predictions[tick % ::predictions.size()];
+  return prediction.tick == tick ? &prediction : nullptr;
+}
+
+bool Mispredicted(
+  PredictedTick const & predicted
+, pul::core::ComponentPlayer const & server
+, glm::vec2 const & serverOrigin
+) {
+  auto const & player = predicted.player;
+  return
+      glm::length(predicted.origin - serverOrigin) > ::mispredictionTolerance
+   || glm::length(player.velocity - server.velocity) > ::mispredictionTolerance
+   || player.grounded         != server.grounded
+   || player.crouching        != server.crouching
+   || player.crouchSliding    != server.crouchSliding
+   || player.wallClingLeft    != server.wallClingLeft
+   || player.wallClingRight   != server.wallClingRight
+   || player.midairDashesLeft != server.midairDashesLeft
+  ;
+}
+
+uint16_t PackButton(bool const value, Button const button) {
+  return static_cast<uint16_t>(static_cast<uint16_t>(value) << Idx(button));
+}
+
+bool UnpackButton(uint16_t const buttons, Button const button) {
+  return (buttons >> Idx(button)) & 1u;
+}
+
+// input comes straight from a client, the direction and weapon index into
+// arrays of the player
+bool ValidPlayerInput(pul::network::PacketPlayerInput const & input) {
+  return
+      input.movementDirection < Idx(pul::Direction::Size)
+   && (
+        input.weaponSwitchToType
+          == pul::network::PacketPlayerInput::NoWeaponSwitch
+     || input.weaponSwitchToType < Idx(pul::core::WeaponType::Size)
+      )
+  ;
+}
+
+} // -- namespace
+
+void plugin::network::RecordPrediction(
+  pul::core::SceneBundle const & scene
+, pul::controls::Controller const & controller
+, pul::core::ComponentPlayer const & player
+, glm::vec2 const & origin
+) {
+  ::latestTick = static_cast<uint32_t>(scene.clock.tick);
+
+  auto & prediction = ::predictions[::latestTick % ::predictions.size()];
+  prediction.tick = ::latestTick;
+  prediction.input = controller.current;
+  prediction.player = player;
+  prediction.origin = origin;
+}
+
+void plugin::network::ReconcilePrediction(
+  pul::core::SceneBundle & scene
+, pul::network::SnapshotEntity const & serverState
+, uint32_t const inputTick
+) {
+  // nothing to compare against until the server has run one of our inputs
+  if (inputTick == pul::network::PacketSnapshot::NoBaseline) { return; }
+
+  auto & registry = scene.EnttRegistry();
+
+  auto view =
+    registry.view<
+      pul::core::ComponentPlayerControllable
+    , pul::core::ComponentPlayer
+    , pul::core::ComponentOrigin
+    , pul::core::ComponentHitboxAABB
+    , pul::core::ComponentDamageable
+    , pul::animation::ComponentInstance
+    >();
+
+  for (auto entity : view) {
+    auto & player = view.get<pul::core::ComponentPlayer>(entity);
+    auto & origin = view.get<pul::core::ComponentOrigin>(entity);
+    auto & hitbox = view.get<pul::core::ComponentHitboxAABB>(entity);
+    auto & damageable = view.get<pul::core::ComponentDamageable>(entity);
+    auto const & animation =
+      view.get<pul::animation::ComponentInstance>(entity);
+
+    auto * predicted = ::FindPrediction(inputTick);
+
+    // whatever is not replicated is taken from the prediction of that tick,
+    // health & armor are never predicted so they are applied either way
+    pul::core::ComponentPlayer serverPlayer =
+      predicted ? predicted->player : player;
+    glm::vec2 serverOrigin;
+    plugin::network::ReadPlayerState(
+      serverState, serverPlayer, serverOrigin, damageable
+    );
+
+    if (predicted && !::Mispredicted(*predicted, serverPlayer, serverOrigin))
+      { continue; }
+
+    // -- rewind, the inventory is not replayed so keep the newest one
+    auto inventory = std::move(player.inventory);
+    player = std::move(serverPlayer);
+    player.inventory = std::move(inventory);
+    origin.origin = serverOrigin;
+
+    if (predicted) {
+      predicted->player = player;
+      predicted->origin = origin.origin;
+    }
+
+    // -- replay every input the server has not simulated yet
+    pul::controls::Controller controls;
+    if (predicted) { controls.current = predicted->input; }
+
+    size_t replayed = 0ul;
+    for (uint32_t tick = inputTick + 1u; tick <= ::latestTick; ++ tick) {
+      auto * prediction = ::FindPrediction(tick);
+      if (!prediction) { break; }
+
+      controls.previous = controls.current;
+      controls.current = prediction->input;
+
+      plugin::entity::PredictPlayerMovement(
+        scene, controls, player, origin.origin, hitbox, animation
+      );
+
+      prediction->player = player;
+      prediction->origin = origin.origin;
+      ++ replayed;
+    }
+
+    plugin::physics::UpdateEntityBroadphase(scene, entity);
+
+    spdlog::debug(
+      "misprediction of tick {}, replayed {} inputs", inputTick, replayed
+    );
+  }
+}
+
+void plugin::network::CapturePlayerInput(
+  pul::core::SceneBundle const & scene
+, pul::network::PacketPlayerInput & input
+) {
+  auto const & frame = scene.PlayerController().current;
+
+  input.tick = static_cast<uint32_t>(scene.clock.tick);
+
+  input.buttons =
+      ::PackButton(frame.jump,           Button::Jump)
+    | ::PackButton(frame.dash,           Button::Dash)
+    | ::PackButton(frame.crouch,         Button::Crouch)
+    | ::PackButton(frame.walk,           Button::Walk)
+    | ::PackButton(frame.taunt,          Button::Taunt)
+    | ::PackButton(frame.shootPrimary,   Button::ShootPrimary)
+    | ::PackButton(frame.shootSecondary, Button::ShootSecondary)
+  ;
+
+  input.movementHorizontal = static_cast<int8_t>(frame.movementHorizontal);
+  input.movementVertical = static_cast<int8_t>(frame.movementVertical);
+  input.movementDirection = static_cast<uint8_t>(frame.movementDirection);
+
+  input.weaponSwitchToType =
+    frame.weaponSwitchToType == -1u
+      ? pul::network::PacketPlayerInput::NoWeaponSwitch
+      : static_cast<uint8_t>(frame.weaponSwitchToType);
+  input.weaponSwitch = frame.weaponSwitch;
+
+  input.lookDirection = { frame.lookDirection.x, frame.lookDirection.y };
+  input.lookOffset = { frame.lookOffset.x, frame.lookOffset.y };
+  input.lookAngle = frame.lookAngle;
+}
+
+void plugin::network::ApplyNetworkPlayerInput(
+  pul::core::SceneBundle & scene
+, uint32_t const networkId
+, pul::network::PacketPlayerInput const * input
+) {
+  auto & registry = scene.EnttRegistry();
+
+  auto const entity = static_cast<entt::entity>(networkId);
+  if (
+      !registry.valid(entity)
+   || !registry.has<pul::core::ComponentNetworkControllable>(entity)
+  ) {
+    spdlog::error("no network player {} to apply input to", networkId);
+    return;
+  }
+
+  auto & controller =
+    registry.get<pul::controls::ComponentController>(entity).controller;
+
+  controller.previous = controller.current;
+
+  if (!input) { return; }
+
+  if (!::ValidPlayerInput(*input)) {
+    spdlog::error("invalid input from network player {}", networkId);
+    return;
+  }
+
+  auto & networkControllable =
+    registry.get<pul::core::ComponentNetworkControllable>(entity);
+  networkControllable.rewindMs =
+      input->viewTick == pul::network::PacketSnapshot::NoBaseline
+   || input->viewTick > scene.clock.tick
+    ? 0.0f
+    : static_cast<float>(scene.clock.tick - input->viewTick)
+    * scene.clock.tickMs;
+
+  using Movement = pul::controls::Controller::Movement;
+
+  auto & frame = controller.current;
+  frame = {};
+
+  frame.jump           = ::UnpackButton(input->buttons, Button::Jump);
+  frame.dash           = ::UnpackButton(input->buttons, Button::Dash);
+  frame.crouch         = ::UnpackButton(input->buttons, Button::Crouch);
+  frame.walk           = ::UnpackButton(input->buttons, Button::Walk);
+  frame.taunt          = ::UnpackButton(input->buttons, Button::Taunt);
+  frame.shootPrimary   = ::UnpackButton(input->buttons, Button::ShootPrimary);
+  frame.shootSecondary =
+    ::UnpackButton(input->buttons, Button::ShootSecondary);
+
+  frame.movementHorizontal = static_cast<Movement>(input->movementHorizontal);
+  frame.movementVertical = static_cast<Movement>(input->movementVertical);
+  frame.movementDirection =
+    static_cast<pul::Direction>(input->movementDirection);
+
+  frame.weaponSwitchToType =
+    input->weaponSwitchToType
+      == pul::network::PacketPlayerInput::NoWeaponSwitch
+    ? -1u : input->weaponSwitchToType;
+  frame.weaponSwitch = input->weaponSwitch;
+
+  frame.lookDirection =
+    glm::vec2(input->lookDirection[0], input->lookDirection[1]);
+  frame.lookOffset = glm::vec2(input->lookOffset[0], input->lookOffset[1]);
+  frame.lookAngle = input->lookAngle;
+}
+
+void plugin::network::ClearPredictions() {
+  ::predictions.fill({});
+  ::latestTick = pul::network::PacketSnapshot::NoBaseline;
+}
@@ -0,0 +1,397 @@
+#include <plugin-base/network/replication.hpp>
+
+#include <plugin-base/entity/player.hpp>
+#include <plugin-base/network/prediction.hpp>
+
+#include <pulcher-animation/animation.hpp>
+#include <pulcher-core/pickup.hpp>
+#include <pulcher-core/player.hpp>
+#include <pulcher-core/scene-bundle.hpp>
+#include <pulcher-network/snapshot.hpp>
+#include <pulcher-util/enum.hpp>
+#include <pulcher-util/log.hpp>
+
+#include <entt/entt.hpp>
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace {
+
+// -- word layouts of the replicated entities
+
+enum struct PlayerWord : size_t {
+  OriginX, OriginY
+, VelocityX, VelocityY
+, StoredVelocityX, StoredVelocityY
+, LookAtAngle
+, HealthArmor
+, Flags
+, FacingWeaponDashes
+, JumpFallTime
+, CrouchSlideCooldown
+, SlideFrictionTime
+, DashZeroGravityTime
+, DashCooldown
+, DashLock = DashCooldown + Idx(pul::Direction::Size)
+, Size
+};
+
+static_assert(
+  Idx(PlayerWord::Size) <= pul::network::SnapshotEntity::MaxWords
+);
+
+enum struct PlayerFlag : uint32_t {
+  Flip, AffectedByGravity, Jumping, CrouchSliding, Crouching
+, HasReleasedJump, Grounded, WallClingLeft, WallClingRight, Landing
+};
+
+enum struct PickupWord : size_t {
+  OriginX, OriginY
+, TypeSpawned
+, SpawnTimer
+};
+
+// network ID -> local entity of everything a snapshot has been applied to
+std::unordered_map<uint32_t, entt::entity> playerReplicas;
+std::unordered_map<uint32_t, entt::entity> pickupReplicas;
+
+uint32_t NetworkId(entt::entity const entity) {
+  return static_cast<uint32_t>(entity);
+}
+
+uint32_t PackFlag(bool const value, PlayerFlag const flag) {
+  return static_cast<uint32_t>(value) << Idx(flag);
+}
+
+bool UnpackFlag(uint32_t const flags, PlayerFlag const flag) {
+  return (flags >> Idx(flag)) & 1u;
+}
+
+float F32(pul::network::SnapshotEntity const & entity, auto const word) {
+  return entity.F32(Idx(word));
+}
+
+uint32_t U32(pul::network::SnapshotEntity const & entity, auto const word) {
+  return entity.U32(Idx(word));
+}
+
+void CapturePlayer(
+  pul::network::SnapshotEntity & entity
+, pul::core::ComponentPlayer const & player
+, pul::core::ComponentOrigin const & origin
+, pul::core::ComponentDamageable const & damageable
+) {
+  entity.type = pul::network::SnapshotEntityType::Player;
+
+  entity.Push(origin.origin.x);
+  entity.Push(origin.origin.y);
+  entity.Push(player.velocity.x);
+  entity.Push(player.velocity.y);
+  entity.Push(player.storedVelocity.x);
+  entity.Push(player.storedVelocity.y);
+  entity.Push(player.lookAtAngle);
+  entity.Push(
+      static_cast<uint32_t>(static_cast<uint16_t>(damageable.health))
+    | static_cast<uint32_t>(static_cast<uint16_t>(damageable.armor)) << 16u
+  );
+  entity.Push(
+      ::PackFlag(player.flip,              PlayerFlag::Flip)
+    | ::PackFlag(player.affectedByGravity, PlayerFlag::AffectedByGravity)
+    | ::PackFlag(player.jumping,           PlayerFlag::Jumping)
+    | ::PackFlag(player.crouchSliding,     PlayerFlag::CrouchSliding)
+    | ::PackFlag(player.crouching,         PlayerFlag::Crouching)
+    | ::PackFlag(player.hasReleasedJump,   PlayerFlag::HasReleasedJump)
+    | ::PackFlag(player.grounded,          PlayerFlag::Grounded)
+    | ::PackFlag(player.wallClingLeft,     PlayerFlag::WallClingLeft)
+    | ::PackFlag(player.wallClingRight,    PlayerFlag::WallClingRight)
+    | ::PackFlag(player.landing,           PlayerFlag::Landing)
+  );
+  entity.Push(
+      (static_cast<uint32_t>(Idx(player.facingDirection)) & 0xFFu)
+    | (static_cast<uint32_t>(Idx(player.inventory.currentWeapon)) & 0xFFu)
+        << 8u
+    | (static_cast<uint32_t>(player.midairDashesLeft) & 0xFFu) << 16u
+  );
+  entity.Push(player.jumpFallTime);
+  entity.Push(player.crouchSlideCooldown);
+  entity.Push(player.slideFrictionTime);
+  entity.Push(player.dashZeroGravityTime);
+
+  uint32_t dashLock = 0u;
+  for (size_t it = 0ul; it < player.dashCooldown.size(); ++ it) {
+    entity.Push(player.dashCooldown[it]);
+    dashLock |= static_cast<uint32_t>(player.dashLock[it]) << it;
+  }
+  entity.Push(dashLock);
+}
+
+void ApplyPlayer(
+  pul::core::SceneBundle & scene
+, pul::network::SnapshotEntity const & entity
+) {
+  auto & registry = scene.EnttRegistry();
+
+  auto replica = ::playerReplicas.find(entity.networkId);
+  if (replica == ::playerReplicas.end()) {
+    entt::entity playerEntity;
+    plugin::entity::ConstructPlayer(playerEntity, scene, false);
+
+    // follows the snapshots instead of a bot
+    registry.remove<pul::core::ComponentBotControllable>(playerEntity);
+
+    replica = ::playerReplicas.emplace(entity.networkId, playerEntity).first;
+  }
+
+  auto & player = registry.get<pul::core::ComponentPlayer>(replica->second);
+  auto & origin = registry.get<pul::core::ComponentOrigin>(replica->second);
+  auto & damageable =
+    registry.get<pul::core::ComponentDamageable>(replica->second);
+  auto & animation =
+    registry.get<pul::animation::ComponentInstance>(replica->second);
+
+  plugin::network::ReadPlayerState(entity, player, origin.origin, damageable);
+
+  // same offset UpdatePlayer renders the player at
+  animation.instance.origin = origin.origin + glm::vec2(0.0f, 28.0f);
+}
+
+void ApplyPickup(
+  pul::core::SceneBundle & scene
+, pul::network::SnapshotEntity const & entity
+) {
+  auto & registry = scene.EnttRegistry();
+
+  glm::vec2 const origin =
+    glm::vec2(
+      ::F32(entity, PickupWord::OriginX), ::F32(entity, PickupWord::OriginY)
+    );
+
+  auto replica = ::pickupReplicas.find(entity.networkId);
+  if (replica == ::pickupReplicas.end()) {
+    // pickups are placed by the map, so both sides already have them
+    auto view = registry.view<pul::core::ComponentPickup>();
+    for (auto pickupEntity : view) {
+      if (view.get<pul::core::ComponentPickup>(pickupEntity).origin != origin)
+        { continue; }
+
+      replica = ::pickupReplicas.emplace(entity.networkId, pickupEntity).first;
+      break;
+    }
+
+    if (replica == ::pickupReplicas.end()) {
+      spdlog::error("no local pickup at {} to replicate onto", origin);
+      return;
+    }
+  }
+
+  auto & pickup = registry.get<pul::core::ComponentPickup>(replica->second);
+  pickup.spawned = (::U32(entity, PickupWord::TypeSpawned) >> 16u) & 1u;
+  pickup.spawnTimer = ::F32(entity, PickupWord::SpawnTimer);
+}
+
+} // -- namespace
+
+void plugin::network::CaptureSnapshot(
+  pul::core::SceneBundle const & scene
+, pul::network::Snapshot & snapshot
+) {
+  auto const & registry = scene.EnttRegistry();
+
+  snapshot.entities.clear();
+
+  { // -- players
+    auto view =
+      registry.view<
+        const pul::core::ComponentPlayer
+      , const pul::core::ComponentOrigin
+      , const pul::core::ComponentDamageable
+      >();
+
+    for (auto entity : view) {
+      auto & snapshotEntity = snapshot.entities.emplace_back();
+      snapshotEntity.networkId = ::NetworkId(entity);
+      ::CapturePlayer(
+        snapshotEntity
+      , view.get<const pul::core::ComponentPlayer>(entity)
+      , view.get<const pul::core::ComponentOrigin>(entity)
+      , view.get<const pul::core::ComponentDamageable>(entity)
+      );
+    }
+  }
+
+  // projectiles & grenades are not captured until clients can construct
+  // replicas of them, a client only sees those its own weapons spawn
+
+  { // -- pickups
+    auto view = registry.view<const pul::core::ComponentPickup>();
+
+    for (auto entity : view) {
+      auto const & pickup = view.get<const pul::core::ComponentPickup>(entity);
+
+      auto & snapshotEntity = snapshot.entities.emplace_back();
+      snapshotEntity.networkId = ::NetworkId(entity);
+      snapshotEntity.type = pul::network::SnapshotEntityType::Pickup;
+      snapshotEntity.Push(pickup.origin.x);
+      snapshotEntity.Push(pickup.origin.y);
+      snapshotEntity.Push(
+          (static_cast<uint32_t>(Idx(pickup.type)) & 0xFFu)
+        | (static_cast<uint32_t>(Idx(pickup.weaponType)) & 0xFFu) << 8u
+        | static_cast<uint32_t>(pickup.spawned) << 16u
+      );
+      snapshotEntity.Push(pickup.spawnTimer);
+    }
+  }
+
+  snapshot.Sort();
+}
+
+void plugin::network::ApplySnapshot(
+  pul::core::SceneBundle & scene
+, pul::network::Snapshot const & snapshot
+, uint32_t const localNetworkId
+, uint32_t const inputTick
+) {
+  auto & registry = scene.EnttRegistry();
+
+  auto const inSnapshot = [&snapshot](uint32_t const networkId) {
+    auto const entity =
+      std::lower_bound(
+        snapshot.entities.begin(), snapshot.entities.end(), networkId
+      , [](auto const & snapshotEntity, uint32_t const id) {
+          return snapshotEntity.networkId < id;
+        }
+      );
+    return
+      entity != snapshot.entities.end() && entity->networkId == networkId;
+  };
+
+  // -- remove players that left the server
+  for (auto replica = ::playerReplicas.begin();
+       replica != ::playerReplicas.end();
+  ) {
+    if (inSnapshot(replica->first)) { ++ replica; continue; }
+
+    if (registry.valid(replica->second)) {
+      registry.destroy(
+        registry.get<pul::core::ComponentPlayer>(replica->second)
+          .weaponAnimation
+      );
+      registry.destroy(replica->second);
+    }
+
+    replica = ::playerReplicas.erase(replica);
+  }
+
+  for (auto const & entity : snapshot.entities) {
+    switch (entity.type) {
+      default: break;
+      case pul::network::SnapshotEntityType::Player:
+        if (entity.networkId == localNetworkId)
+          { plugin::network::ReconcilePrediction(scene, entity, inputTick); }
+        else
+          { ::ApplyPlayer(scene, entity); }
+      break;
+      case pul::network::SnapshotEntityType::Pickup:
+        ::ApplyPickup(scene, entity);
+      break;
+    }
+  }
+}
+
+uint32_t plugin::network::ConstructNetworkPlayer(
+  pul::core::SceneBundle & scene
+) {
+  auto & registry = scene.EnttRegistry();
+
+  entt::entity playerEntity;
+  plugin::entity::ConstructPlayer(playerEntity, scene, false);
+
+  registry.remove<pul::core::ComponentBotControllable>(playerEntity);
+  registry.emplace<pul::core::ComponentNetworkControllable>(playerEntity);
+
+  return ::NetworkId(playerEntity);
+}
+
+void plugin::network::DestroyNetworkPlayer(
+  pul::core::SceneBundle & scene, uint32_t const networkId
+) {
+  auto & registry = scene.EnttRegistry();
+
+  auto const playerEntity = static_cast<entt::entity>(networkId);
+  if (
+      !registry.valid(playerEntity)
+   || !registry.has<pul::core::ComponentNetworkControllable>(playerEntity)
+  ) {
+    spdlog::error("no network player {} to destroy", networkId);
+    return;
+  }
+
+  registry.destroy(
+    registry.get<pul::core::ComponentPlayer>(playerEntity).weaponAnimation
+  );
+  registry.destroy(playerEntity);
+}
+
+void plugin::network::ReadPlayerState(
+  pul::network::SnapshotEntity const & entity
+, pul::core::ComponentPlayer & player
+, glm::vec2 & origin
+, pul::core::ComponentDamageable & damageable
+) {
+  origin =
+    glm::vec2(
+      ::F32(entity, PlayerWord::OriginX), ::F32(entity, PlayerWord::OriginY)
+    );
+
+  player.velocity =
+    glm::vec2(
+      ::F32(entity, PlayerWord::VelocityX)
+    , ::F32(entity, PlayerWord::VelocityY)
+    );
+  player.storedVelocity =
+    glm::vec2(
+      ::F32(entity, PlayerWord::StoredVelocityX)
+    , ::F32(entity, PlayerWord::StoredVelocityY)
+    );
+  player.lookAtAngle = ::F32(entity, PlayerWord::LookAtAngle);
+
+  uint32_t const healthArmor = ::U32(entity, PlayerWord::HealthArmor);
+  damageable.health = static_cast<int16_t>(healthArmor & 0xFFFFu);
+  damageable.armor  = static_cast<int16_t>(healthArmor >> 16u);
+
+  uint32_t const flags = ::U32(entity, PlayerWord::Flags);
+  player.flip              = ::UnpackFlag(flags, PlayerFlag::Flip);
+  player.affectedByGravity = ::UnpackFlag(flags, PlayerFlag::AffectedByGravity);
+  player.jumping           = ::UnpackFlag(flags, PlayerFlag::Jumping);
+  player.crouchSliding     = ::UnpackFlag(flags, PlayerFlag::CrouchSliding);
+  player.crouching         = ::UnpackFlag(flags, PlayerFlag::Crouching);
+  player.hasReleasedJump   = ::UnpackFlag(flags, PlayerFlag::HasReleasedJump);
+  player.grounded          = ::UnpackFlag(flags, PlayerFlag::Grounded);
+  player.wallClingLeft     = ::UnpackFlag(flags, PlayerFlag::WallClingLeft);
+  player.wallClingRight    = ::UnpackFlag(flags, PlayerFlag::WallClingRight);
+  player.landing           = ::UnpackFlag(flags, PlayerFlag::Landing);
+
+  uint32_t const packed = ::U32(entity, PlayerWord::FacingWeaponDashes);
+  player.facingDirection = static_cast<pul::Direction>(packed & 0xFFu);
+  player.inventory.currentWeapon =
+    static_cast<pul::core::WeaponType>((packed >> 8u) & 0xFFu);
+  player.midairDashesLeft = static_cast<int32_t>((packed >> 16u) & 0xFFu);
+
+  player.jumpFallTime        = ::F32(entity, PlayerWord::JumpFallTime);
+  player.crouchSlideCooldown = ::F32(entity, PlayerWord::CrouchSlideCooldown);
+  player.slideFrictionTime   = ::F32(entity, PlayerWord::SlideFrictionTime);
+  player.dashZeroGravityTime = ::F32(entity, PlayerWord::DashZeroGravityTime);
+
+  uint32_t const dashLock = ::U32(entity, PlayerWord::DashLock);
+  for (size_t it = 0ul; it < player.dashCooldown.size(); ++ it) {
+    player.dashCooldown[it] =
+      entity.F32(Idx(PlayerWord::DashCooldown) + it);
+    player.dashLock[it] = (dashLock >> it) & 1u;
+  }
+}
+
+void plugin::network::Shutdown() {
+  ::playerReplicas.clear();
+  ::pickupReplicas.clear();
+}
@@ -17,7 +17,14 @@
 #include <glad/glad.hpp>
 #include <imgui/imgui.hpp>
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <limits>
+#include <map>
 #include <span>
+#include <tuple>
+#include <unordered_map>
 #include <vector>
 
 namespace {
@@ -31,34 +38,339 @@ bool showPhysicsQueries = true;
 
 pul::physics::TilemapLayer tilemapLayer;
 
-float CalculateSdfDistance(
+// chunk of the most recent tile lookup, neighbouring lookups mostly land in
+// the same chunk
+uint64_t cachedChunkKey = 0ul;
+pul::physics::TilemapLayer::Chunk const * cachedChunk = nullptr;
+
+// spatial hash of entity hitboxes, rebuilt every logic tick; entity queries
+// only test the entities of the cells they touch
+int32_t constexpr entityCellSize = 128;
+
+struct EntityCellBounds {
+  glm::i32vec2 cellMin, cellMax;
+};
+
+std::unordered_map<uint64_t, std::vector<entt::entity>> entityCells;
+std::unordered_map<entt::entity, EntityCellBounds> entityCellBounds;
+std::vector<entt::entity> entityCandidates;
+
+// order in which a batch of rays is traced
+std::vector<std::pair<uint64_t, size_t>> rayBatchOrder;
+
+// tile coordinate of the collision layer that contains the pixel origin,
+// floored so that negative origins map to negative tiles
+glm::i32vec2 TileCoordinate(glm::i32vec2 const & origin) {
+  return
+    glm::i32vec2(
+      pul::util::FloorDiv(origin.x, 32), pul::util::FloorDiv(origin.y, 32)
+    );
+}
+
+// key of a cell in a sparse grid, coordinates can be negative
+uint64_t CellKey(glm::i32vec2 const & cell) {
+  return
+    (static_cast<uint64_t>(static_cast<uint32_t>(cell.x)) << 32ul)
+  | static_cast<uint64_t>(static_cast<uint32_t>(cell.y));
+}
+
+// returns nullptr if the tile coordinate is outside of the collision layer.
+// Tiles of chunks without geometry are empty
+pul::physics::TilemapLayer::TileInfo const * FetchTileInfo(
+  glm::i32vec2 const & tile
+) {
+  static pul::physics::TilemapLayer::TileInfo const emptyTileInfo = {};
+
+  if (
+      tile.x <  ::tilemapLayer.tileMin.x || tile.y <  ::tilemapLayer.tileMin.y
+   || tile.x >= ::tilemapLayer.tileMax.x || tile.y >= ::tilemapLayer.tileMax.y
+  ) {
+    return nullptr;
+  }
+
+  using Chunk = pul::physics::TilemapLayer::Chunk;
+
+  glm::i32vec2 const chunk =
+    glm::i32vec2(
+      pul::util::FloorDiv(tile.x, Chunk::size)
+    , pul::util::FloorDiv(tile.y, Chunk::size)
+    );
+
+  uint64_t const chunkKey = ::CellKey(chunk);
+
+  if (!::cachedChunk || ::cachedChunkKey != chunkKey) {
+    auto chunkIt = ::tilemapLayer.chunks.find(chunkKey);
+    if (chunkIt == ::tilemapLayer.chunks.end()) { return &emptyTileInfo; }
+
+    ::cachedChunkKey = chunkKey;
+    ::cachedChunk = &chunkIt->second;
+  }
+
+  glm::i32vec2 const local = tile - chunk*Chunk::size;
+  return &::cachedChunk->tiles[local.y*Chunk::size + local.x];
+}
+
+// tileset information of the tile, all indices are -1 for empty tiles
+pul::physics::TilemapLayer::OrientedTileInfo const & FetchOrientedTileInfo(
   pul::physics::TilemapLayer::TileInfo const & tileInfo
-, glm::u32vec2 texel
 ) {
-  if (tileInfo.tilesetIdx == -1ul) { return 0.0f; }
+  static pul::physics::TilemapLayer::OrientedTileInfo const emptyInfo = {};
 
-  auto const * tileset = tilemapLayer.tilesets[tileInfo.tilesetIdx];
+  if (!tileInfo.Valid()) { return emptyInfo; }
 
-  if (!tileInfo.Valid()) { return 0.0f; }
+  return ::tilemapLayer.orientedTileInfo[tileInfo.orientedTileIdx];
+}
 
-  pul::physics::Tile const & physicsTile =
-    tileset->tiles[tileInfo.imageTileIdx];
+// returns nullptr for tiles of the collision layer that have no image, these
+// are empty. The tile is already oriented as it is placed on the layer
+pul::physics::Tile const * FetchPhysicsTile(
+  pul::physics::TilemapLayer::TileInfo const & tileInfo
+) {
+  if (!tileInfo.Valid()) { return nullptr; }
 
-  // apply tile orientation
-  auto const tileOrientation = Idx(tileInfo.orientation);
+  return &::tilemapLayer.orientedTiles[tileInfo.orientedTileIdx];
+}
+
+// converts a texel coordinate of the collision layer into the coordinate of
+// the tileset image, the extent is the amount of texels along an axis
+glm::u32vec2 ApplyTileOrientation(
+  glm::u32vec2 coord
+, pul::core::TileOrientation const orientation
+, uint32_t const extent
+) {
+  auto const tileOrientation = Idx(orientation);
 
   if (tileOrientation & Idx(pul::core::TileOrientation::FlipHorizontal))
-    { texel.x = 31 - texel.x; }
+    { coord.x = extent - 1u - coord.x; }
 
   if (tileOrientation & Idx(pul::core::TileOrientation::FlipVertical))
-    { texel.y = 31 - texel.y; }
+    { coord.y = extent - 1u - coord.y; }
 
   if (tileOrientation & Idx(pul::core::TileOrientation::FlipDiagonal)) {
-    std::swap(texel.x, texel.y);
+    std::swap(coord.x, coord.y);
+  }
+
+  return coord;
+}
+
+// returns nullptr if the tile has no distance field
+pul::physics::TileDistanceField const * FetchDistanceField(
+  pul::physics::TilemapLayer::TileInfo const & tileInfo
+) {
+  size_t const distanceFieldIdx =
+    ::FetchOrientedTileInfo(tileInfo).distanceFieldIdx;
+
+  if (distanceFieldIdx == -1ul) { return nullptr; }
+  return &::tilemapLayer.distanceFields[distanceFieldIdx];
+}
+
+// bits [begin, end] set
+uint32_t CalculateSpanMask(uint32_t const begin, uint32_t const end) {
+  return (0xFFFFFFFFu >> (31u - end)) & (0xFFFFFFFFu << begin);
+}
+
+bool CalculateTexelSolid(
+  pul::physics::TilemapLayer::TileInfo const & tileInfo
+, glm::u32vec2 const & texel
+) {
+  auto const * physicsTile = ::FetchPhysicsTile(tileInfo);
+  if (!physicsTile) { return false; }
+
+  return (physicsTile->collisionRows[texel.y] >> texel.x) & 1u;
+}
+
+// steps through the texels of a mixed tile that the line covers in
+// [stepBegin, stepEnd), looking for a texel with the requested occupancy.
+// Consecutive pixels of the line are at most one texel apart, so every pixel
+// closer than the SDF distance of the current pixel can be skipped. The SDF
+// only knows about its own tile, so that skip is also limited to the distance
+// to the tile border. Tiles without an SDF are stepped texel by texel
+bool TraceTile(
+  pul::physics::PixelLine const & line
+, glm::i32vec2 const & tile
+, pul::physics::TilemapLayer::TileInfo const & tileInfo
+, pul::physics::Tile const & physicsTile
+, int32_t const stepBegin, int32_t const stepEnd
+, bool const searchSolid
+, int32_t & hitStep
+) {
+  auto const * distanceField = ::FetchDistanceField(tileInfo);
+
+  for (int32_t step = stepBegin; step < stepEnd;) {
+    glm::u32vec2 const texel = glm::u32vec2(line.Pixel(step) - tile*32);
+
+    if (!distanceField) {
+      bool const solid = (physicsTile.collisionRows[texel.y] >> texel.x) & 1u;
+
+      if (solid == searchSolid) {
+        hitStep = step;
+        return true;
+      }
+
+      ++ step;
+      continue;
+    }
+
+    int32_t const distance = distanceField->distance[texel.x][texel.y];
+
+    if ((distance < 0) == searchSolid) {
+      hitStep = step;
+      return true;
+    }
+
+    int32_t const tileBorderDistance =
+      static_cast<int32_t>(
+        glm::min(
+          glm::min(texel.x+1u, texel.y+1u), glm::min(32u-texel.x, 32u-texel.y)
+        )
+      );
+
+    step += glm::max(1, glm::min(glm::abs(distance), tileBorderDistance));
+  }
+
+  return false;
+}
+
+// two-level traversal of the ray until a pixel with the requested occupancy
+// is found; the tiles along the line are visited in order with a DDA over the
+// tile grid, uniform tiles are resolved without touching texels and only
+// mixed tiles are stepped through
+bool TraceRay(
+  pul::physics::IntersectorRay const & ray
+, bool const searchSolid
+, pul::physics::IntersectionResults & intersectionResults
+) {
+  auto const line =
+    pul::physics::PixelLine::Construct(ray.beginOrigin, ray.endOrigin);
+
+  pul::physics::TraverseGridLine(
+    line, 32
+  , [&](
+      glm::i32vec2 const & tile, int32_t const stepBegin, int32_t const stepEnd
+    ) -> bool {
+      auto const * tileInfo = ::FetchTileInfo(tile);
+
+      // outside of the collision layer nothing can be intersected
+      if (!tileInfo) { return false; }
+
+      auto const * physicsTile = ::FetchPhysicsTile(*tileInfo);
+
+      auto const hint = ::FetchOrientedTileInfo(*tileInfo).accelerationHint;
+
+      int32_t hitStep = stepBegin;
+
+      if (hint != pul::physics::TileIntersectAccelerationHint::Default) {
+        bool const tileSolid =
+          hint == pul::physics::TileIntersectAccelerationHint::Full;
+        if (tileSolid != searchSolid) { return false; }
+      } else if (
+        !::TraceTile(
+          line, tile, *tileInfo, *physicsTile
+        , stepBegin, stepEnd, searchSolid, hitStep
+        )
+      ) {
+        return false;
+      }
+
+      auto const & orientedTileInfo = ::FetchOrientedTileInfo(*tileInfo);
+
+      intersectionResults =
+        pul::physics::IntersectionResults {
+          true, line.Pixel(hitStep)
+        , orientedTileInfo.imageTileIdx, orientedTileInfo.tilesetIdx
+        };
+
+      return true;
+    }
+  );
+
+  return intersectionResults.collision;
+}
+
+// the tileset tile as it is placed on the collision layer
+pul::physics::Tile OrientTile(
+  pul::physics::Tile const & physicsTile
+, pul::core::TileOrientation const orientation
+) {
+  pul::physics::Tile orientedTile = physicsTile;
+  orientedTile.collisionRows = {};
+
+  for (uint32_t y = 0u; y < pul::physics::Tile::gridSize; ++ y)
+  for (uint32_t x = 0u; x < pul::physics::Tile::gridSize; ++ x) {
+    glm::u32vec2 const texel =
+      ::ApplyTileOrientation(
+        glm::u32vec2(x, y), orientation, pul::physics::Tile::gridSize
+      );
+
+    orientedTile.collisionRows[y] |=
+      ((physicsTile.collisionRows[texel.y] >> texel.x) & 1u) << x;
+  }
+
+  return orientedTile;
+}
+
+// chebyshev distance transform of a tile towards texels matching `target`;
+// a two-pass chamfer with unit weights is exact for the chebyshev metric
+std::array<
+  std::array<int32_t, pul::physics::Tile::gridSize>
+, pul::physics::Tile::gridSize
+> ComputeDistanceTransform(
+  pul::physics::Tile const & physicsTile
+, bool const target
+) {
+  int32_t constexpr gridSize = pul::physics::Tile::gridSize;
+
+  std::array<std::array<int32_t, gridSize>, gridSize> distance;
+
+  for (int32_t x = 0; x < gridSize; ++ x)
+  for (int32_t y = 0; y < gridSize; ++ y) {
+    bool const solid = (physicsTile.collisionRows[y] >> x) & 1u;
+    distance[x][y] =
+      solid == target ? 0 : pul::physics::TileDistanceField::maxDistance;
+  }
+
+  auto const relax = [&](int32_t x, int32_t y, int32_t nx, int32_t ny) {
+    if (nx < 0 || ny < 0 || nx >= gridSize || ny >= gridSize) { return; }
+    distance[x][y] = glm::min(distance[x][y], distance[nx][ny] + 1);
+  };
+
+  for (int32_t y = 0; y < gridSize; ++ y)
+  for (int32_t x = 0; x < gridSize; ++ x) {
+    relax(x, y, x-1, y);
+    relax(x, y, x-1, y-1);
+    relax(x, y, x,   y-1);
+    relax(x, y, x+1, y-1);
+  }
+
+  for (int32_t y = gridSize-1; y >= 0; -- y)
+  for (int32_t x = gridSize-1; x >= 0; -- x) {
+    relax(x, y, x+1, y);
+    relax(x, y, x+1, y+1);
+    relax(x, y, x,   y+1);
+    relax(x, y, x-1, y+1);
+  }
+
+  return distance;
+}
+
+pul::physics::TileDistanceField ComputeDistanceField(
+  pul::physics::Tile const & physicsTile
+) {
+  auto const distanceToSolid = ::ComputeDistanceTransform(physicsTile, true);
+  auto const distanceToEmpty = ::ComputeDistanceTransform(physicsTile, false);
+
+  pul::physics::TileDistanceField distanceField;
+
+  for (size_t x = 0ul; x < pul::physics::Tile::gridSize; ++ x)
+  for (size_t y = 0ul; y < pul::physics::Tile::gridSize; ++ y) {
+    bool const solid = (physicsTile.collisionRows[y] >> x) & 1u;
+    distanceField.distance[x][y] =
+      static_cast<int8_t>(
+        solid ? -distanceToEmpty[x][y] : distanceToSolid[x][y]
+      );
   }
 
-  // -- compute intersection SDF and accel hints
-  return physicsTile.signedDistanceField[texel.x][texel.y];
+  return distanceField;
 }
 
 glm::vec2 GetAabbMin(glm::vec2 const & aabbOrigin, glm::vec2 const & aabbDim) {
@@ -78,15 +390,29 @@ bool IntersectionRayAabb(
 , glm::vec2 const & aabbOrigin, glm::vec2 const & aabbDim
 , float & intersectionLength
 ) {
-  glm::vec2 normal = glm::normalize(rayEnd - rayBegin);
-  normal.x = normal.x == 0.0f ? 1.0f : 1.0f / normal.x;
-  normal.y = normal.y == 0.0f ? 1.0f : 1.0f / normal.y;
+  if (rayBegin == rayEnd) { return false; }
 
-  glm::vec2 const min = (GetAabbMin(aabbOrigin, aabbDim) - rayBegin) * normal;
-  glm::vec2 const max = (GetAabbMax(aabbOrigin, aabbDim) - rayBegin) * normal;
+  glm::vec2 const direction = glm::normalize(rayEnd - rayBegin);
+  glm::vec2 const aabbMin = GetAabbMin(aabbOrigin, aabbDim);
+  glm::vec2 const aabbMax = GetAabbMax(aabbOrigin, aabbDim);
 
-  float tmin = glm::max(glm::min(min.x, max.x), glm::min(min.y, max.y));
-  float tmax = glm::min(glm::max(min.x, max.x), glm::max(min.y, max.y));
+  float tmin = -std::numeric_limits<float>::infinity();
+  float tmax =  std::numeric_limits<float>::infinity();
+
+  for (size_t axis = 0ul; axis < 2ul; ++ axis) {
+    // parallel to the slab, the ray is either always or never inside of it
+    if (direction[axis] == 0.0f) {
+      if (rayBegin[axis] < aabbMin[axis] || rayBegin[axis] > aabbMax[axis])
+        { return false; }
+      continue;
+    }
+
+    float const t0 = (aabbMin[axis] - rayBegin[axis]) / direction[axis];
+    float const t1 = (aabbMax[axis] - rayBegin[axis]) / direction[axis];
+
+    tmin = glm::max(tmin, glm::min(t0, t1));
+    tmax = glm::min(tmax, glm::max(t0, t1));
+  }
 
   if (tmax < 0.0f || tmin > tmax)
     { return false; }
@@ -111,22 +437,464 @@ bool IntersectionCircleAabb(
   return glm::length(circleOrigin - closestOrigin) <= circleRadius;
 }
 
+// point moving along pointVelocity against an aabb moving along aabbVelocity
+// over the same frame, tested as the point's motion relative to the aabb.
+// Points that begin inside of the aabb have their contact at 0
+bool SweepPointAabb(
+  glm::vec2 const & pointOrigin, glm::vec2 const & pointVelocity
+, glm::vec2 const & aabbOrigin, glm::vec2 const & aabbDim
+, glm::vec2 const & aabbVelocity
+, float & timeOfImpact
+) {
+  glm::vec2 const aabbMin = GetAabbMin(aabbOrigin, aabbDim);
+  glm::vec2 const aabbMax = GetAabbMax(aabbOrigin, aabbDim);
+  glm::vec2 const velocity = pointVelocity - aabbVelocity;
+
+  float enter = 0.0f;
+  float exit  = 1.0f;
+
+  for (size_t axis = 0ul; axis < 2ul; ++ axis) {
+    if (velocity[axis] == 0.0f) {
+      if (
+          pointOrigin[axis] < aabbMin[axis]
+       || pointOrigin[axis] > aabbMax[axis]
+      ) {
+        return false;
+      }
+      continue;
+    }
+
+    float const t0 = (aabbMin[axis] - pointOrigin[axis]) / velocity[axis];
+    float const t1 = (aabbMax[axis] - pointOrigin[axis]) / velocity[axis];
+
+    enter = glm::max(enter, glm::min(t0, t1));
+    exit  = glm::min(exit,  glm::max(t0, t1));
+  }
+
+  if (enter > exit) { return false; }
+
+  timeOfImpact = enter;
+  return true;
+}
+
+// swept aabb of [boxMin, boxMax] moving along velocity against the static
+// [solidMin, solidMax], keeps the earliest contact. Boxes that already overlap
+// are ignored, and touching along an axis the box does not move on is not a
+// contact, so bodies resting against geometry can slide along it
+struct SweepContact {
+  float timeOfImpact = std::numeric_limits<float>::infinity();
+  size_t axis = 0ul;
+  glm::vec2 solidMin, solidMax;
+  pul::physics::TilemapLayer::TileInfo const * tileInfo = nullptr;
+};
+
+void SweepAabbAabb(
+  glm::vec2 const & boxMin, glm::vec2 const & boxMax
+, glm::vec2 const & velocity
+, glm::vec2 const & solidMin, glm::vec2 const & solidMax
+, pul::physics::TilemapLayer::TileInfo const & tileInfo
+, SweepContact & contact
+) {
+  float enter = -std::numeric_limits<float>::infinity();
+  float exit  =  std::numeric_limits<float>::infinity();
+  size_t enterAxis = 0ul;
+
+  for (size_t axis = 0ul; axis < 2ul; ++ axis) {
+    if (velocity[axis] == 0.0f) {
+      if (boxMax[axis] <= solidMin[axis] || boxMin[axis] >= solidMax[axis])
+        { return; }
+      continue;
+    }
+
+    bool const positive = velocity[axis] > 0.0f;
+
+    float const axisEnter =
+      (positive ? solidMin[axis] - boxMax[axis] : solidMax[axis] - boxMin[axis])
+    / velocity[axis];
+
+    float const axisExit =
+      (positive ? solidMax[axis] - boxMin[axis] : solidMin[axis] - boxMax[axis])
+    / velocity[axis];
+
+    // ties prefer the vertical axis, so landing on a corner grounds
+    if (axisEnter >= enter) { enter = axisEnter; enterAxis = axis; }
+    exit = glm::min(exit, axisExit);
+  }
+
+  if (enter < 0.0f || enter > 1.0f || enter >= exit) { return; }
+  if (enter >= contact.timeOfImpact) { return; }
+
+  contact.timeOfImpact = enter;
+  contact.axis = enterAxis;
+  contact.solidMin = solidMin;
+  contact.solidMax = solidMax;
+  contact.tileInfo = &tileInfo;
+}
+
+// sweeps against every solid texel of the tile that overlaps the swept
+// bounds [texelMin, texelMax] (inclusive, in layer texels). Full tiles and
+// runs of solid texels along a row are swept as a single box, unless the aabb
+// already overlaps them; then only the texels it does not overlap yet can be
+// entered
+void SweepTile(
+  glm::vec2 const & boxMin, glm::vec2 const & boxMax
+, glm::vec2 const & velocity
+, glm::i32vec2 const & tile
+, glm::i32vec2 const & texelMin, glm::i32vec2 const & texelMax
+, SweepContact & contact
+) {
+  auto const * tileInfo = ::FetchTileInfo(tile);
+  if (!tileInfo) { return; }
+
+  auto const * physicsTile = ::FetchPhysicsTile(*tileInfo);
+  if (!physicsTile) { return; }
+
+  using Hint = pul::physics::TileIntersectAccelerationHint;
+
+  auto const hint = ::FetchOrientedTileInfo(*tileInfo).accelerationHint;
+
+  if (hint == Hint::Empty) { return; }
+
+  glm::i32vec2 const tileOrigin = tile*32;
+
+  auto const overlaps =
+    [&](glm::vec2 const & regionMin, glm::vec2 const & regionMax) {
+    return
+        boxMin.x < regionMax.x && boxMax.x > regionMin.x
+     && boxMin.y < regionMax.y && boxMax.y > regionMin.y
+    ;
+  };
+
+  if (
+      hint == Hint::Full
+   && !overlaps(glm::vec2(tileOrigin), glm::vec2(tileOrigin + 32))
+  ) {
+    ::SweepAabbAabb(
+      boxMin, boxMax, velocity
+    , glm::vec2(tileOrigin), glm::vec2(tileOrigin + 32)
+    , *tileInfo, contact
+    );
+    return;
+  }
+
+  // texel range local to the tile
+  glm::u32vec2 const localMin =
+    glm::u32vec2(glm::max(texelMin - tileOrigin, glm::i32vec2(0)));
+  glm::u32vec2 const localMax =
+    glm::u32vec2(glm::min(texelMax - tileOrigin, glm::i32vec2(31)));
+
+  uint32_t const spanMask = ::CalculateSpanMask(localMin.x, localMax.x);
+
+  for (uint32_t y = localMin.y; y <= localMax.y; ++ y) {
+    uint32_t bits = physicsTile->collisionRows[y] & spanMask;
+
+    while (bits) {
+      uint32_t const runBegin = std::countr_zero(bits);
+      uint32_t const runEnd = runBegin + std::countr_one(bits >> runBegin);
+      bits &= ~::CalculateSpanMask(runBegin, runEnd-1u);
+
+      glm::vec2 const runMin =
+        glm::vec2(tileOrigin + glm::i32vec2(runBegin, y));
+      glm::vec2 const runMax =
+        glm::vec2(tileOrigin + glm::i32vec2(runEnd, y+1u));
+
+      if (!overlaps(runMin, runMax)) {
+        ::SweepAabbAabb(
+          boxMin, boxMax, velocity, runMin, runMax, *tileInfo, contact
+        );
+        continue;
+      }
+
+      for (uint32_t x = runBegin; x < runEnd; ++ x) {
+        glm::vec2 const texel = glm::vec2(tileOrigin + glm::i32vec2(x, y));
+        ::SweepAabbAabb(
+          boxMin, boxMax, velocity, texel, texel + 1.0f, *tileInfo, contact
+        );
+      }
+    }
+  }
+}
+
+// raycasts test the hitbox centered on the origin while circles apply the
+// hitbox offset, so both are covered, as well as the hitbox moving along its
+// motion over the next tick for swept queries. Grown by a texel so that rays,
+// which are traversed as rasterized lines, can not slip past a corner
+EntityCellBounds CalculateEntityCellBounds(
+  pul::core::ComponentHitboxAABB const & hitbox
+, glm::vec2 const & origin
+, glm::vec2 const & motion
+) {
+  glm::vec2 const halfDimensions = glm::vec2(hitbox.dimensions) * 0.5f;
+  glm::vec2 const offsetOrigin = origin + glm::vec2(hitbox.offset);
+
+  glm::vec2 const boundsMin =
+    glm::min(glm::min(origin, offsetOrigin), origin + motion)
+  - halfDimensions - 1.0f;
+  glm::vec2 const boundsMax =
+    glm::max(glm::max(origin, offsetOrigin), origin + motion)
+  + halfDimensions + 1.0f;
+
+  return
+    EntityCellBounds {
+      glm::i32vec2(glm::floor(boundsMin / static_cast<float>(entityCellSize)))
+    , glm::i32vec2(glm::floor(boundsMax / static_cast<float>(entityCellSize)))
+    };
+}
+
+void InsertEntityCells(entt::entity entity, EntityCellBounds const & bounds) {
+  for (int32_t y = bounds.cellMin.y; y <= bounds.cellMax.y; ++ y)
+  for (int32_t x = bounds.cellMin.x; x <= bounds.cellMax.x; ++ x)
+    { ::entityCells[::CellKey({x, y})].emplace_back(entity); }
+
+  ::entityCellBounds[entity] = bounds;
+}
+
+void RemoveEntityCells(entt::entity entity) {
+  auto boundsIt = ::entityCellBounds.find(entity);
+  if (boundsIt == ::entityCellBounds.end()) { return; }
+
+  auto const & bounds = boundsIt->second;
+  for (int32_t y = bounds.cellMin.y; y <= bounds.cellMax.y; ++ y)
+  for (int32_t x = bounds.cellMin.x; x <= bounds.cellMax.x; ++ x) {
+    auto & cell = ::entityCells[::CellKey({x, y})];
+    cell.erase(std::remove(cell.begin(), cell.end(), entity), cell.end());
+  }
+
+  ::entityCellBounds.erase(boundsIt);
+}
+
+void GatherEntityCell(glm::i32vec2 const & cell) {
+  auto cellIt = ::entityCells.find(::CellKey(cell));
+  if (cellIt == ::entityCells.end()) { return; }
+
+  ::entityCandidates.insert(
+    ::entityCandidates.end(), cellIt->second.begin(), cellIt->second.end()
+  );
+}
+
+// where the entity moves over a tick from its current origin. Projectiles
+// are updated before the players of the same tick, so they are swept against
+// the motion the players are about to make rather than the one they made.
+// Only players move, along the velocity they were left with
+glm::vec2 EntityTickMotion(
+  pul::core::SceneBundle const & scene, entt::entity entity
+) {
+  auto const * player =
+    scene.EnttRegistry().try_get<pul::core::ComponentPlayer>(entity);
+  return player ? player->velocity*scene.clock.TickScale() : glm::vec2(0.0f);
+}
+
+// entities spanning multiple cells are gathered once per cell
+void UniqueEntityCandidates() {
+  std::sort(::entityCandidates.begin(), ::entityCandidates.end());
+  ::entityCandidates.erase(
+    std::unique(::entityCandidates.begin(), ::entityCandidates.end())
+  , ::entityCandidates.end()
+  );
+}
+
+// -- hitbox history; where every hitbox was over the last ticks so that hits
+//    can be tested against what a client saw when it fired. A frame stores
+//    its hitboxes as columns sorted by entity, so rewound queries can cull
+//    with a linear sweep and consecutive frames can be matched by a merge
+
+struct HitboxFrame {
+  size_t tick = 0ul;
+  bool valid = false;
+
+  std::vector<entt::entity> entities;
+  std::vector<float> originX, originY;
+  std::vector<float> offsetX, offsetY;
+  std::vector<float> halfWidth, halfHeight;
+
+  size_t Size() const { return entities.size(); }
+
+  void Clear() {
+    entities.clear();
+    originX.clear(); originY.clear();
+    offsetX.clear(); offsetY.clear();
+    halfWidth.clear(); halfHeight.clear();
+  }
+};
+
+// covers plugin::physics::MaxRewindMs at tick rates up to 250 Hz
+std::array<HitboxFrame, 64ul> hitboxHistory;
+
+// hitboxes of the most recent rewound query, interpolated to its time. Only
+// the ones that could overlap the bounds of the query are kept
+HitboxFrame rewoundHitboxes;
+
+std::vector<entt::entity> hitboxHistoryOrder;
+
+HitboxFrame const * FindHitboxFrame(size_t const tick) {
+  auto const & frame = ::hitboxHistory[tick % ::hitboxHistory.size()];
+  return frame.valid && frame.tick == tick ? &frame : nullptr;
+}
+
+// interpolates the hitboxes of rewindMs ago that overlap the bounds into
+// rewoundHitboxes, centered on their origin or offset from it. Returns false
+// if the history does not reach back that far. Entities that did not exist
+// yet at that time are not part of it.
+// A hitbox is culled against the union of where it was in the frames on
+// either side of that time, which holds wherever it is in between, so only
+// the hitboxes that survive the cull are interpolated
+bool RewindHitboxes(
+  pul::core::SimulationClock const & clock, float const rewindMs
+, glm::vec2 const & boundsMin, glm::vec2 const & boundsMax, bool const offset
+) {
+  float const ticksBack =
+    glm::min(rewindMs, plugin::physics::MaxRewindMs) / clock.tickMs;
+
+  size_t const wholeTicksBack = static_cast<size_t>(glm::ceil(ticksBack));
+  if (wholeTicksBack == 0ul || wholeTicksBack > clock.tick) { return false; }
+
+  auto const * before = ::FindHitboxFrame(clock.tick - wholeTicksBack);
+  if (!before) { return false; }
+
+  // the current tick is not recorded until it has been simulated, in that
+  // case the frame before it is as close as it gets
+  auto const * after = ::FindHitboxFrame(clock.tick - wholeTicksBack + 1ul);
+  float const towardsAfter = static_cast<float>(wholeTicksBack) - ticksBack;
+  if (towardsAfter <= 0.0f) { after = nullptr; }
+
+  float const offsetScale = offset ? 1.0f : 0.0f;
+
+  auto & rewound = ::rewoundHitboxes;
+  rewound.Clear();
+  rewound.tick = before->tick;
+  rewound.valid = true;
+
+  size_t afterIdx = 0ul;
+  for (size_t idx = 0ul; idx < before->Size(); ++ idx) {
+    float beforeX = before->originX[idx], beforeY = before->originY[idx];
+    float afterX = beforeX, afterY = beforeY;
+
+    if (after) {
+      while (
+          afterIdx < after->Size()
+       && after->entities[afterIdx] < before->entities[idx]
+      ) {
+        ++ afterIdx;
+      }
+
+      if (
+          afterIdx < after->Size()
+       && after->entities[afterIdx] == before->entities[idx]
+      ) {
+        afterX = after->originX[afterIdx];
+        afterY = after->originY[afterIdx];
+      }
+    }
+
+    float const offsetX = before->offsetX[idx]*offsetScale;
+    float const offsetY = before->offsetY[idx]*offsetScale;
+
+    if (
+        glm::max(beforeX, afterX) + offsetX + before->halfWidth[idx]
+          < boundsMin.x
+     || glm::min(beforeX, afterX) + offsetX - before->halfWidth[idx]
+          > boundsMax.x
+     || glm::max(beforeY, afterY) + offsetY + before->halfHeight[idx]
+          < boundsMin.y
+     || glm::min(beforeY, afterY) + offsetY - before->halfHeight[idx]
+          > boundsMax.y
+    ) {
+      continue;
+    }
+
+    rewound.entities.emplace_back(before->entities[idx]);
+    rewound.originX.emplace_back(glm::mix(beforeX, afterX, towardsAfter));
+    rewound.originY.emplace_back(glm::mix(beforeY, afterY, towardsAfter));
+    rewound.offsetX.emplace_back(before->offsetX[idx]);
+    rewound.offsetY.emplace_back(before->offsetY[idx]);
+    rewound.halfWidth.emplace_back(before->halfWidth[idx]);
+    rewound.halfHeight.emplace_back(before->halfHeight[idx]);
+  }
+
+  return true;
+}
+
+// intersections given as (length along the ray, entity), closest first
+void EmitRayIntersections(
+  glm::vec2 const & rayOriginBegin, glm::vec2 const & rayOriginEnd
+, std::vector<std::pair<float, entt::entity>> & intersections
+, pul::physics::EntityIntersectionResults & intersectionResults
+) {
+  std::sort(intersections.begin(), intersections.end());
+
+  for (auto const & [intersectionLength, entity] : intersections) {
+    glm::vec2 const intersectionOrigin =
+        rayOriginBegin
+      + intersectionLength * glm::normalize(rayOriginEnd - rayOriginBegin)
+    ;
+
+    intersectionResults.collision = true;
+    std::pair<glm::i32vec2, entt::entity> results;
+    std::get<0>(results) = glm::i32vec2(glm::round(intersectionOrigin));
+    std::get<1>(results) = entity;
+    intersectionResults.entities.emplace_back(results);
+  }
+}
+
 } // -- namespace
 
 // -- plugin functions
-void plugin::physics::EntityIntersectionRaycast(
+void plugin::physics::RebuildEntityBroadphase(
   pul::core::SceneBundle & scene
-, pul::physics::IntersectorRay const & ray
-, pul::physics::EntityIntersectionResults & intersectionResults
 ) {
   auto & registry = scene.EnttRegistry();
 
+  // keep the allocations of the cells around, the map barely changes
+  for (auto & cell : ::entityCells) { cell.second.clear(); }
+  ::entityCellBounds.clear();
+
   auto view =
     registry.view<
       pul::core::ComponentHitboxAABB
     , pul::core::ComponentOrigin
     >();
 
+  for (auto entity : view) {
+    auto const & origin = view.get<pul::core::ComponentOrigin>(entity).origin;
+
+    ::InsertEntityCells(
+      entity
+    , ::CalculateEntityCellBounds(
+        view.get<pul::core::ComponentHitboxAABB>(entity)
+      , origin, ::EntityTickMotion(scene, entity)
+      )
+    );
+  }
+}
+
+void plugin::physics::UpdateEntityBroadphase(
+  pul::core::SceneBundle & scene
+, entt::entity entity
+) {
+  auto & registry = scene.EnttRegistry();
+
+  ::RemoveEntityCells(entity);
+
+  auto const * hitbox =
+    registry.try_get<pul::core::ComponentHitboxAABB>(entity);
+  auto const * origin = registry.try_get<pul::core::ComponentOrigin>(entity);
+  if (!hitbox || !origin) { return; }
+
+  ::InsertEntityCells(
+    entity
+  , ::CalculateEntityCellBounds(
+      *hitbox, origin->origin, ::EntityTickMotion(scene, entity)
+    )
+  );
+}
+
+void plugin::physics::EntityIntersectionRaycast(
+  pul::core::SceneBundle & scene
+, pul::physics::IntersectorRay const & ray
+, pul::physics::EntityIntersectionResults & intersectionResults
+) {
+  auto & registry = scene.EnttRegistry();
+
   intersectionResults.entities.clear();
 
   glm::vec2 const
@@ -134,9 +902,26 @@ void plugin::physics::EntityIntersectionRaycast(
   , rayOriginEnd = glm::vec2(ray.endOrigin)
   ;
 
-  for (auto & entity : view) {
-    auto const & hitbox = view.get<pul::core::ComponentHitboxAABB>(entity);
-    auto const & origin = view.get<pul::core::ComponentOrigin>(entity);
+  // -- gather entities of the cells along the ray
+  ::entityCandidates.clear();
+  pul::physics::TraverseGridLine(
+    pul::physics::PixelLine::Construct(ray.beginOrigin, ray.endOrigin)
+  , ::entityCellSize
+  , [](glm::i32vec2 const & cell, int32_t, int32_t) {
+      ::GatherEntityCell(cell);
+      return false;
+    }
+  );
+  ::UniqueEntityCandidates();
+
+  // closest intersection first
+  std::vector<std::pair<float, entt::entity>> intersections;
+
+  for (auto entity : ::entityCandidates) {
+    if (!registry.valid(entity)) { continue; }
+
+    auto const & hitbox = registry.get<pul::core::ComponentHitboxAABB>(entity);
+    auto const & origin = registry.get<pul::core::ComponentOrigin>(entity);
 
     float intersectionLength;
     bool const intersection =
@@ -146,45 +931,164 @@ void plugin::physics::EntityIntersectionRaycast(
       , intersectionLength
       );
 
-    if (intersection) {
-      glm::vec2 const intersectionOrigin =
-          rayOriginBegin
-        + intersectionLength * glm::normalize(rayOriginEnd - rayOriginBegin)
-      ;
+    if (intersection)
+      { intersections.emplace_back(intersectionLength, entity); }
+  }
+
+  ::EmitRayIntersections(
+    rayOriginBegin, rayOriginEnd, intersections, intersectionResults
+  );
+}
+
+void plugin::physics::EntityIntersectionCircle(
+  pul::core::SceneBundle & scene
+, pul::physics::IntersectorCircle const & circle
+, pul::physics::EntityIntersectionResults & intersectionResults
+) {
+  auto & registry = scene.EnttRegistry();
+
+  intersectionResults.entities.clear();
+
+  // -- gather entities of the cells the circle's bounds touch
+  glm::i32vec2 const cellMin =
+    glm::i32vec2(
+      glm::floor(
+        (glm::vec2(circle.origin) - circle.radius)
+      / static_cast<float>(::entityCellSize)
+      )
+    );
+  glm::i32vec2 const cellMax =
+    glm::i32vec2(
+      glm::floor(
+        (glm::vec2(circle.origin) + circle.radius)
+      / static_cast<float>(::entityCellSize)
+      )
+    );
+
+  ::entityCandidates.clear();
+  for (int32_t y = cellMin.y; y <= cellMax.y; ++ y)
+  for (int32_t x = cellMin.x; x <= cellMax.x; ++ x)
+    { ::GatherEntityCell({x, y}); }
+  ::UniqueEntityCandidates();
+
+  for (auto entity : ::entityCandidates) {
+    if (!registry.valid(entity)) { continue; }
+
+    auto const & hitbox = registry.get<pul::core::ComponentHitboxAABB>(entity);
+    auto const & origin = registry.get<pul::core::ComponentOrigin>(entity);
+
+    glm::vec2 closestOrigin;
+    bool intersection =
+      ::IntersectionCircleAabb(
+        glm::vec2(circle.origin), circle.radius
+      , origin.origin + glm::vec2(hitbox.offset), glm::vec2(hitbox.dimensions)
+      , closestOrigin
+      );
 
+    if (intersection) {
       intersectionResults.collision = true;
       std::pair<glm::i32vec2, entt::entity> results;
-      std::get<0>(results) = glm::i32vec2(glm::round(intersectionOrigin));
+      std::get<0>(results) = glm::i32vec2(glm::round(closestOrigin));
       std::get<1>(results) = entity;
       intersectionResults.entities.emplace_back(results);
     }
   }
 }
 
-void plugin::physics::EntityIntersectionCircle(
+void plugin::physics::EntityIntersectionRaycastRewound(
   pul::core::SceneBundle & scene
-, pul::physics::IntersectorCircle const & circle
+, pul::physics::IntersectorRay const & ray
+, float const rewindMs
 , pul::physics::EntityIntersectionResults & intersectionResults
 ) {
+  glm::vec2 const
+    rayOriginBegin = glm::vec2(ray.beginOrigin)
+  , rayOriginEnd = glm::vec2(ray.endOrigin)
+  ;
+
+  if (
+      rewindMs <= 0.0f
+   || !::RewindHitboxes(
+        scene.clock, rewindMs
+      , glm::min(rayOriginBegin, rayOriginEnd)
+      , glm::max(rayOriginBegin, rayOriginEnd)
+      , false
+      )
+  ) {
+    plugin::physics::EntityIntersectionRaycast(scene, ray, intersectionResults);
+    return;
+  }
+
   auto & registry = scene.EnttRegistry();
 
-  auto view =
-    registry.view<
-      pul::core::ComponentHitboxAABB
-    , pul::core::ComponentOrigin
-    >();
+  intersectionResults.entities.clear();
+
+  auto const & rewound = ::rewoundHitboxes;
+
+  std::vector<std::pair<float, entt::entity>> intersections;
+
+  for (size_t idx = 0ul; idx < rewound.Size(); ++ idx) {
+    auto const entity = rewound.entities[idx];
+    if (!registry.valid(entity)) { continue; }
+
+    float intersectionLength;
+    bool const intersection =
+      ::IntersectionRayAabb(
+        rayOriginBegin, rayOriginEnd
+      , glm::vec2(rewound.originX[idx], rewound.originY[idx])
+      , 2.0f * glm::vec2(rewound.halfWidth[idx], rewound.halfHeight[idx])
+      , intersectionLength
+      );
+
+    if (intersection)
+      { intersections.emplace_back(intersectionLength, entity); }
+  }
+
+  ::EmitRayIntersections(
+    rayOriginBegin, rayOriginEnd, intersections, intersectionResults
+  );
+}
+
+void plugin::physics::EntityIntersectionCircleRewound(
+  pul::core::SceneBundle & scene
+, pul::physics::IntersectorCircle const & circle
+, float const rewindMs
+, pul::physics::EntityIntersectionResults & intersectionResults
+) {
+  glm::vec2 const circleOrigin = glm::vec2(circle.origin);
+
+  if (
+      rewindMs <= 0.0f
+   || !::RewindHitboxes(
+        scene.clock, rewindMs
+      , circleOrigin - circle.radius, circleOrigin + circle.radius, true
+      )
+  ) {
+    plugin::physics::EntityIntersectionCircle(
+      scene, circle, intersectionResults
+    );
+    return;
+  }
+
+  auto & registry = scene.EnttRegistry();
 
   intersectionResults.entities.clear();
 
-  for (auto & entity : view) {
-    auto const & hitbox = view.get<pul::core::ComponentHitboxAABB>(entity);
-    auto const & origin = view.get<pul::core::ComponentOrigin>(entity);
+  auto const & rewound = ::rewoundHitboxes;
+
+  for (size_t idx = 0ul; idx < rewound.Size(); ++ idx) {
+    auto const entity = rewound.entities[idx];
+    if (!registry.valid(entity)) { continue; }
 
     glm::vec2 closestOrigin;
-    bool intersection =
+    bool const intersection =
       ::IntersectionCircleAabb(
-        glm::vec2(circle.origin), circle.radius
-      , origin.origin + glm::vec2(hitbox.offset), glm::vec2(hitbox.dimensions)
+        circleOrigin, circle.radius
+      , glm::vec2(
+          rewound.originX[idx] + rewound.offsetX[idx]
+        , rewound.originY[idx] + rewound.offsetY[idx]
+        )
+      , 2.0f * glm::vec2(rewound.halfWidth[idx], rewound.halfHeight[idx])
       , closestOrigin
       );
 
@@ -198,6 +1102,107 @@ void plugin::physics::EntityIntersectionCircle(
   }
 }
 
+void plugin::physics::RecordHitboxHistory(pul::core::SceneBundle & scene) {
+  auto & registry = scene.EnttRegistry();
+
+  auto & frame = ::hitboxHistory[scene.clock.tick % ::hitboxHistory.size()];
+  frame.Clear();
+  frame.tick = scene.clock.tick;
+  frame.valid = true;
+
+  auto view =
+    registry.view<
+      pul::core::ComponentHitboxAABB
+    , pul::core::ComponentOrigin
+    >();
+
+  ::hitboxHistoryOrder.assign(view.begin(), view.end());
+  std::sort(::hitboxHistoryOrder.begin(), ::hitboxHistoryOrder.end());
+
+  for (auto entity : ::hitboxHistoryOrder) {
+    auto const & hitbox = view.get<pul::core::ComponentHitboxAABB>(entity);
+    auto const & origin = view.get<pul::core::ComponentOrigin>(entity).origin;
+
+    frame.entities.emplace_back(entity);
+    frame.originX.emplace_back(origin.x);
+    frame.originY.emplace_back(origin.y);
+    frame.offsetX.emplace_back(static_cast<float>(hitbox.offset.x));
+    frame.offsetY.emplace_back(static_cast<float>(hitbox.offset.y));
+    frame.halfWidth.emplace_back(hitbox.dimensions.x * 0.5f);
+    frame.halfHeight.emplace_back(hitbox.dimensions.y * 0.5f);
+  }
+}
+
+void plugin::physics::ClearHitboxHistory() {
+  for (auto & frame : ::hitboxHistory) {
+    frame.Clear();
+    frame.valid = false;
+  }
+}
+
+void plugin::physics::EntityIntersectionSweptPoint(
+  pul::core::SceneBundle & scene
+, pul::physics::IntersectorSweptPoint const & sweep
+, pul::physics::EntitySweptIntersectionResults & intersectionResults
+) {
+  auto & registry = scene.EnttRegistry();
+
+  intersectionResults.collision = false;
+  intersectionResults.entities.clear();
+
+  // -- gather entities of the cells along the path, their cells already
+  //    cover the hitbox along its entire motion
+  ::entityCandidates.clear();
+  pul::physics::TraverseGridLine(
+    pul::physics::PixelLine::Construct(
+      glm::i32vec2(glm::round(sweep.origin))
+    , glm::i32vec2(glm::round(sweep.origin + sweep.velocity))
+    )
+  , ::entityCellSize
+  , [](glm::i32vec2 const & cell, int32_t, int32_t) {
+      ::GatherEntityCell(cell);
+      return false;
+    }
+  );
+  ::UniqueEntityCandidates();
+
+  for (auto entity : ::entityCandidates) {
+    if (!registry.valid(entity)) { continue; }
+
+    auto const & hitbox = registry.get<pul::core::ComponentHitboxAABB>(entity);
+    auto const & origin = registry.get<pul::core::ComponentOrigin>(entity);
+
+    // the part of the motion of the tick the sweep covers
+    glm::vec2 const motion = ::EntityTickMotion(scene, entity);
+    float const tickLength = sweep.tickEnd - sweep.tickBegin;
+
+    float timeOfImpact;
+    bool const intersection =
+      ::SweepPointAabb(
+        sweep.origin, sweep.velocity
+      , origin.origin + motion*sweep.tickBegin, glm::vec2(hitbox.dimensions)
+      , motion*tickLength
+      , timeOfImpact
+      );
+
+    if (!intersection) { continue; }
+
+    intersectionResults.collision = true;
+    intersectionResults.entities.emplace_back(
+      pul::physics::EntitySweptIntersectionResults::Contact {
+        timeOfImpact, sweep.origin + sweep.velocity*timeOfImpact, entity
+      }
+    );
+  }
+
+  std::sort(
+    intersectionResults.entities.begin(), intersectionResults.entities.end()
+  , [](auto const & contactA, auto const & contactB) {
+      return contactA.timeOfImpact < contactB.timeOfImpact;
+    }
+  );
+}
+
 void plugin::physics::ProcessTileset(
   pul::physics::Tileset & tileset
 , pul::gfx::Image const & image
@@ -209,6 +1214,7 @@ void plugin::physics::ProcessTileset(
   for (size_t tileY = 0ul; tileY < image.height / 32ul; ++ tileY)
   for (size_t tileX = 0ul; tileX < image.width  / 32ul; ++ tileX) {
     pul::physics::Tile tile;
+    tile.collisionRows = {};
 
     auto constexpr gridSize = pul::physics::Tile::gridSize;
 
@@ -223,10 +1229,13 @@ void plugin::physics::ProcessTileset(
       , gridTexelY = static_cast<size_t>(texelY*(gridSize/32.0f))
       ;
 
-      float const alpha =
-        image.data[(image.height-imageTexelY-1)*image.width + imageTexelX].a;
+      bool const solid =
+        image.data[(image.height-imageTexelY-1)*image.width + imageTexelX].a
+      > 0u;
 
-      tile.signedDistanceField[gridTexelX][gridTexelY] = alpha;
+      if (!solid) { continue; }
+
+      tile.collisionRows[gridTexelY] |= 1u << gridTexelX;
     }
 
     tileset.tiles.emplace_back(tile);
@@ -235,12 +1244,13 @@ void plugin::physics::ProcessTileset(
 
 void plugin::physics::ClearMapGeometry() {
   tilemapLayer = {};
+  ::cachedChunk = nullptr;
 }
 
 void plugin::physics::LoadMapGeometry(
   std::vector<pul::physics::Tileset const *> const & tilesets
 , std::vector<std::span<size_t>>             const & mapTileIndices
-, std::vector<std::span<glm::u32vec2>>       const & mapTileOrigins
+, std::vector<std::span<glm::i32vec2>>       const & mapTileOrigins
 , std::vector<std::span<pul::core::TileOrientation>> const & mapTileOrientations
 ) {
   plugin::physics::ClearMapGeometry();
@@ -256,21 +1266,31 @@ void plugin::physics::LoadMapGeometry(
     return;
   }
 
-  // -- compute max width/height of tilemap
-  uint32_t width = 0ul, height = 0ul;
+  // copy tilesets over
+  ::tilemapLayer.tilesets =
+    decltype(::tilemapLayer.tilesets){tilesets.begin(), tilesets.end()};
+
+  // -- compute bounds of tilemap
+  bool hasTiles = false;
+  ::tilemapLayer.tileMin = glm::i32vec2(std::numeric_limits<int32_t>::max());
+  ::tilemapLayer.tileMax = glm::i32vec2(std::numeric_limits<int32_t>::min());
   for (auto & tileOrigins : mapTileOrigins)
   for (auto & origin : tileOrigins) {
-    width = std::max(width, origin.x+1);
-    height = std::max(height, origin.y+1);
+    hasTiles = true;
+    ::tilemapLayer.tileMin = glm::min(::tilemapLayer.tileMin, origin);
+    ::tilemapLayer.tileMax = glm::max(::tilemapLayer.tileMax, origin + 1);
   }
-  ::tilemapLayer.width = width;
 
-  // copy tilesets over
-  ::tilemapLayer.tilesets =
-    decltype(::tilemapLayer.tilesets){tilesets.begin(), tilesets.end()};
+  if (!hasTiles) {
+    ::tilemapLayer.tileMin = ::tilemapLayer.tileMax = glm::i32vec2(0);
+  }
+
+  // every tileset tile placed on the layer is baked once per orientation it
+  // is placed with (at most eight variants), so queries never have to apply
+  // the orientation. Distance fields are only needed by mixed tiles
+  std::map<std::tuple<size_t, size_t, size_t>, uint32_t> orientedTileIndices;
 
-  // resize
-  ::tilemapLayer.tileInfo.resize(width * height);
+  using Chunk = pul::physics::TilemapLayer::Chunk;
 
   // cache tileset info for quick tile fetching
   for (size_t tilesetIdx = 0ul; tilesetIdx < tilesets.size(); ++ tilesetIdx) {
@@ -289,20 +1309,72 @@ void plugin::physics::LoadMapGeometry(
         imageTileIdx, <, tilesets[tilesetIdx]->tiles.size(), continue;
       );
 
-      size_t const tileIdx = tileOrigin.y * width + tileOrigin.x;
+      // tiles without any collision do not need to be stored, their chunk is
+      // only allocated once it has geometry
+      if (
+          tilesets[tilesetIdx]->tiles[imageTileIdx].AccelerationHint()
+       == pul::physics::TileIntersectAccelerationHint::Empty
+      ) {
+        continue;
+      }
+
+      glm::i32vec2 const chunkOrigin =
+        glm::i32vec2(
+          pul::util::FloorDiv(tileOrigin.x, Chunk::size)
+        , pul::util::FloorDiv(tileOrigin.y, Chunk::size)
+        );
+
+      glm::i32vec2 const local = tileOrigin - chunkOrigin*Chunk::size;
 
-      PUL_ASSERT_CMP(tileIdx, <, ::tilemapLayer.tileInfo.size(), continue;);
+      auto & tile =
+        ::tilemapLayer.chunks[::CellKey(chunkOrigin)]
+          .tiles[local.y*Chunk::size + local.x];
 
-      auto & tile = ::tilemapLayer.tileInfo[tileIdx];
-      if (tile.imageTileIdx != -1ul) {
+      if (tile.Valid()) {
         spdlog::error("multiple tiles are intersecting on the collision layer");
         continue;
       }
 
-      tile.tilesetIdx   = tilesetIdx;
-      tile.imageTileIdx = imageTileIdx;
-      tile.origin       = tileOrigin;
-      tile.orientation  = tileOrientation;
+      auto const key =
+        std::make_tuple(tilesetIdx, imageTileIdx, Idx(tileOrientation));
+
+      auto orientedTileIt = orientedTileIndices.find(key);
+
+      if (orientedTileIt == orientedTileIndices.end()) {
+        auto const orientedTile =
+          ::OrientTile(
+            tilesets[tilesetIdx]->tiles[imageTileIdx], tileOrientation
+          );
+
+        pul::physics::TilemapLayer::OrientedTileInfo info;
+        info.imageTileIdx = imageTileIdx;
+        info.tilesetIdx   = tilesetIdx;
+        info.orientation  = tileOrientation;
+        info.accelerationHint = orientedTile.AccelerationHint();
+
+        if (
+            info.accelerationHint
+         == pul::physics::TileIntersectAccelerationHint::Default
+        ) {
+          info.distanceFieldIdx = ::tilemapLayer.distanceFields.size();
+          ::tilemapLayer.distanceFields.emplace_back(
+            ::ComputeDistanceField(orientedTile)
+          );
+        }
+
+        orientedTileIt =
+          orientedTileIndices
+            .emplace(
+              key
+            , static_cast<uint32_t>(::tilemapLayer.orientedTiles.size())
+            )
+            .first;
+
+        ::tilemapLayer.orientedTiles.emplace_back(orientedTile);
+        ::tilemapLayer.orientedTileInfo.emplace_back(info);
+      }
+
+      tile.orientedTileIdx = orientedTileIt->second;
     }
   }
 }
@@ -313,38 +1385,7 @@ bool plugin::physics::InverseSceneIntersectionRaycast(
 , pul::physics::IntersectionResults & intersectionResults
 ) {
   intersectionResults = {};
-  // TODO this is slow and can be optimized by using SDFs
-  pul::physics::BresenhamLine(
-    ray.beginOrigin, ray.endOrigin
-  , [&](int32_t x, int32_t y) {
-      if (intersectionResults.collision) { return; }
-      auto origin = glm::i32vec2(x, y);
-      // -- get physics tile from acceleration structure
-
-      // calculate tile indices, not for the spritesheet but for the tile in
-      // the physx map
-      size_t tileIdx;
-      glm::u32vec2 texelOrigin;
-      if (
-        !pul::util::CalculateTileIndices(
-          tileIdx, texelOrigin, origin
-        , ::tilemapLayer.width, ::tilemapLayer.tileInfo.size()
-        )
-      ) {
-        return;
-      }
-
-      PUL_ASSERT_CMP(::tilemapLayer.tileInfo.size(), >, tileIdx, return;);
-      auto const & tileInfo = ::tilemapLayer.tileInfo[tileIdx];
-
-      if (::CalculateSdfDistance(tileInfo, texelOrigin) == 0.0f) {
-        intersectionResults =
-          pul::physics::IntersectionResults {
-            true, origin, tileInfo.imageTileIdx, tileInfo.tilesetIdx
-          };
-      }
-    }
-  );
+  ::TraceRay(ray, false, intersectionResults);
 
   if (::showPhysicsQueries) {
     plugin::debug::RenderLine(
@@ -363,38 +1404,7 @@ bool plugin::physics::IntersectionRaycast(
 , pul::physics::IntersectionResults & intersectionResults
 ) {
   intersectionResults = {};
-  // TODO this is slow and can be optimized by using SDFs
-  pul::physics::BresenhamLine(
-    ray.beginOrigin, ray.endOrigin
-  , [&](int32_t x, int32_t y) {
-      if (intersectionResults.collision) { return; }
-      auto origin = glm::i32vec2(x, y);
-      // -- get physics tile from acceleration structure
-
-      // calculate tile indices, not for the spritesheet but for the tile in
-      // the physx map
-      size_t tileIdx;
-      glm::u32vec2 texelOrigin;
-      if (
-        !pul::util::CalculateTileIndices(
-          tileIdx, texelOrigin, origin
-        , ::tilemapLayer.width, ::tilemapLayer.tileInfo.size()
-        )
-      ) {
-        return;
-      }
-
-      PUL_ASSERT_CMP(::tilemapLayer.tileInfo.size(), >, tileIdx, return;);
-      auto const & tileInfo = ::tilemapLayer.tileInfo[tileIdx];
-
-      if (::CalculateSdfDistance(tileInfo, texelOrigin) > 0.0f) {
-        intersectionResults =
-          pul::physics::IntersectionResults {
-            true, origin, tileInfo.imageTileIdx, tileInfo.tilesetIdx
-          };
-      }
-    }
-  );
+  ::TraceRay(ray, true, intersectionResults);
 
   if (::showPhysicsQueries) {
     plugin::debug::RenderLine(
@@ -407,16 +1417,188 @@ bool plugin::physics::IntersectionRaycast(
   return intersectionResults.collision;
 }
 
+void plugin::physics::IntersectionRaycasts(
+  pul::core::SceneBundle &
+, std::span<pul::physics::IntersectorRay const> rays
+, std::span<pul::physics::IntersectionResults> intersectionResults
+) {
+  PUL_ASSERT_CMP(rays.size(), ==, intersectionResults.size(), return;);
+
+  // -- order rays by the tile they begin in, row by row
+  ::rayBatchOrder.clear();
+  ::rayBatchOrder.reserve(rays.size());
+
+  for (size_t rayIdx = 0ul; rayIdx < rays.size(); ++ rayIdx) {
+    glm::i32vec2 const tile = ::TileCoordinate(rays[rayIdx].beginOrigin);
+
+    // rays beginning outside of the layer are traced last
+    glm::u32vec2 const layerTile = glm::u32vec2(tile - ::tilemapLayer.tileMin);
+    uint64_t const key =
+      ::FetchTileInfo(tile)
+    ? (static_cast<uint64_t>(layerTile.y) << 32ul) | layerTile.x
+    : std::numeric_limits<uint64_t>::max();
+
+    ::rayBatchOrder.emplace_back(key, rayIdx);
+  }
+
+  std::sort(::rayBatchOrder.begin(), ::rayBatchOrder.end());
+
+  for (auto const & [key, rayIdx] : ::rayBatchOrder) {
+    auto const & ray = rays[rayIdx];
+    auto & results = intersectionResults[rayIdx];
+
+    results = {};
+    ::TraceRay(ray, true, results);
+
+    if (::showPhysicsQueries) {
+      plugin::debug::RenderLine(
+        ray.beginOrigin, ray.endOrigin,
+        results.collision
+      ? glm::vec4(1.0f, 0.2f, 0.2f, 1.0f) : glm::vec4(0.2f, 1.0f, 0.2f, 1.0f)
+      );
+    }
+  }
+}
+
 pul::physics::TilemapLayer * plugin::physics::TilemapLayer() {
   return &tilemapLayer;
 }
 
 bool plugin::physics::IntersectionAabb(
   pul::core::SceneBundle &
-, pul::physics::IntersectorAabb const &
-, pul::physics::IntersectionResults &
+, pul::physics::IntersectorAabb const & aabb
+, pul::physics::IntersectionResults & intersectionResults
 ) {
-  return false;
+  intersectionResults = {};
+
+  // -- texels the aabb overlaps, touching edges do not overlap
+  glm::vec2 const aabbMin = ::GetAabbMin(aabb.origin, aabb.dimensions);
+  glm::vec2 const aabbMax = ::GetAabbMax(aabb.origin, aabb.dimensions);
+
+  glm::i32vec2 const texelMin = glm::i32vec2(glm::floor(aabbMin));
+  glm::i32vec2 const texelMax = glm::i32vec2(glm::ceil(aabbMax)) - 1;
+
+  glm::i32vec2 const tileMin = ::TileCoordinate(texelMin);
+  glm::i32vec2 const tileMax = ::TileCoordinate(texelMax);
+
+  for (int32_t tileY = tileMin.y; tileY <= tileMax.y; ++ tileY)
+  for (int32_t tileX = tileMin.x; tileX <= tileMax.x; ++ tileX) {
+    if (intersectionResults.collision) { break; }
+
+    glm::i32vec2 const tile = glm::i32vec2(tileX, tileY);
+
+    auto const * tileInfo = ::FetchTileInfo(tile);
+    if (!tileInfo) { continue; }
+
+    auto const * physicsTile = ::FetchPhysicsTile(*tileInfo);
+    if (!physicsTile) { continue; }
+
+    if (
+        ::FetchOrientedTileInfo(*tileInfo).accelerationHint
+     == pul::physics::TileIntersectAccelerationHint::Empty
+    ) {
+      continue;
+    }
+
+    // texel range local to the tile
+    glm::u32vec2 const localMin =
+      glm::u32vec2(glm::max(texelMin - tile*32, glm::i32vec2(0)));
+    glm::u32vec2 const localMax =
+      glm::u32vec2(glm::min(texelMax - tile*32, glm::i32vec2(31)));
+
+    uint32_t const spanMask = ::CalculateSpanMask(localMin.x, localMax.x);
+
+    for (uint32_t y = localMin.y; y <= localMax.y; ++ y) {
+      uint32_t const overlap = physicsTile->collisionRows[y] & spanMask;
+
+      if (!overlap) { continue; }
+
+      auto const & orientedTileInfo = ::FetchOrientedTileInfo(*tileInfo);
+
+      intersectionResults =
+        pul::physics::IntersectionResults {
+          true
+        , tile*32 + glm::i32vec2(std::countr_zero(overlap), y)
+        , orientedTileInfo.imageTileIdx, orientedTileInfo.tilesetIdx
+        };
+      break;
+    }
+  }
+
+  if (::showPhysicsQueries) {
+    plugin::debug::RenderAabbByCenter(
+      aabb.origin, aabb.dimensions*0.5f,
+      intersectionResults.collision
+    ? glm::vec4(1.0f, 0.2f, 0.2f, 1.0f) : glm::vec4(0.2f, 1.0f, 0.2f, 1.0f)
+    );
+  }
+
+  return intersectionResults.collision;
+}
+
+bool plugin::physics::IntersectionSweptAabb(
+  pul::core::SceneBundle &
+, pul::physics::IntersectorSweptAabb const & sweep
+, pul::physics::SweptIntersectionResults & intersectionResults
+) {
+  intersectionResults = {};
+  intersectionResults.origin = sweep.origin + sweep.velocity;
+
+  glm::vec2 const boxMin = ::GetAabbMin(sweep.origin, sweep.dimensions);
+  glm::vec2 const boxMax = ::GetAabbMax(sweep.origin, sweep.dimensions);
+
+  // -- bounds of the entire sweep, in texels and then in tiles. Grown by a
+  //    texel so that surfaces touched at the end of the sweep are included
+  glm::i32vec2 const texelMin =
+    glm::i32vec2(glm::floor(glm::min(boxMin, boxMin + sweep.velocity))) - 1;
+  glm::i32vec2 const texelMax =
+    glm::i32vec2(glm::ceil(glm::max(boxMax, boxMax + sweep.velocity)));
+
+  glm::i32vec2 const tileMin = ::TileCoordinate(texelMin);
+  glm::i32vec2 const tileMax = ::TileCoordinate(texelMax);
+
+  ::SweepContact contact;
+
+  for (int32_t tileY = tileMin.y; tileY <= tileMax.y; ++ tileY)
+  for (int32_t tileX = tileMin.x; tileX <= tileMax.x; ++ tileX) {
+    ::SweepTile(
+      boxMin, boxMax, sweep.velocity, glm::i32vec2(tileX, tileY)
+    , texelMin, texelMax, contact
+    );
+  }
+
+  if (contact.tileInfo) {
+    size_t const axis = contact.axis;
+    bool const positive = sweep.velocity[axis] > 0.0f;
+
+    intersectionResults.collision = true;
+    intersectionResults.timeOfImpact = contact.timeOfImpact;
+    intersectionResults.origin =
+      sweep.origin + sweep.velocity*contact.timeOfImpact;
+
+    // place the aabb exactly against the contacted surface, so that rounding
+    // can not leave it slightly inside of the geometry
+    intersectionResults.origin[axis] =
+      positive
+    ? contact.solidMin[axis] - sweep.dimensions[axis]*0.5f
+    : contact.solidMax[axis] + sweep.dimensions[axis]*0.5f;
+
+    auto const & orientedTileInfo = ::FetchOrientedTileInfo(*contact.tileInfo);
+
+    intersectionResults.normal[axis] = positive ? -1 : +1;
+    intersectionResults.imageTileIdx = orientedTileInfo.imageTileIdx;
+    intersectionResults.tilesetIdx = orientedTileInfo.tilesetIdx;
+  }
+
+  if (::showPhysicsQueries) {
+    plugin::debug::RenderAabbByCenter(
+      intersectionResults.origin, sweep.dimensions*0.5f,
+      intersectionResults.collision
+    ? glm::vec4(1.0f, 0.2f, 0.2f, 1.0f) : glm::vec4(0.2f, 1.0f, 0.2f, 1.0f)
+    );
+  }
+
+  return intersectionResults.collision;
 }
 
 bool plugin::physics::IntersectionPoint(
@@ -428,25 +1610,22 @@ bool plugin::physics::IntersectionPoint(
 
 
   // -- get physics tile from acceleration structure
-  size_t tileIdx;
-  glm::u32vec2 texelOrigin;
-  if (
-    !pul::util::CalculateTileIndices(
-      tileIdx, texelOrigin, point.origin
-    , ::tilemapLayer.width, ::tilemapLayer.tileInfo.size()
-    )
-  ) {
+  glm::i32vec2 const tile = ::TileCoordinate(point.origin);
+  glm::u32vec2 const texelOrigin = glm::u32vec2(point.origin - tile*32);
+
+  auto const * tileInfo = ::FetchTileInfo(tile);
+  if (!tileInfo) {
     // TODO point
     return false;
   }
 
-  PUL_ASSERT_CMP(::tilemapLayer.tileInfo.size(), >, tileIdx, return false;);
-  auto const & tileInfo = ::tilemapLayer.tileInfo[tileIdx];
+  if (::CalculateTexelSolid(*tileInfo, texelOrigin)) {
+    auto const & orientedTileInfo = ::FetchOrientedTileInfo(*tileInfo);
 
-  if (::CalculateSdfDistance(tileInfo, texelOrigin) > 0.0f) {
     intersectionResults =
       pul::physics::IntersectionResults {
-        true, point.origin, tileInfo.imageTileIdx, tileInfo.tilesetIdx
+        true, point.origin
+      , orientedTileInfo.imageTileIdx, orientedTileInfo.tilesetIdx
       };
 
     // TODO point
@@ -460,8 +1639,17 @@ bool plugin::physics::IntersectionPoint(
 void plugin::physics::DebugUiDispatch(pul::core::SceneBundle &) {
   ImGui::Begin("Physics");
 
-  pul::imgui::Text("tilemap width {}", ::tilemapLayer.width);
-  pul::imgui::Text("tile info size {}", ::tilemapLayer.tileInfo.size());
+  pul::imgui::Text(
+    "tilemap bounds {}x{} .. {}x{}"
+  , ::tilemapLayer.tileMin.x, ::tilemapLayer.tileMin.y
+  , ::tilemapLayer.tileMax.x, ::tilemapLayer.tileMax.y
+  );
+  pul::imgui::Text("tile chunks {}", ::tilemapLayer.chunks.size());
+  pul::imgui::Text("oriented tiles {}", ::tilemapLayer.orientedTiles.size());
+  pul::imgui::Text("entity cells {}", ::entityCells.size());
+  pul::imgui::Text(
+    "distance fields {}", ::tilemapLayer.distanceFields.size()
+  );
 
   ImGui::Checkbox("show physics queries", &::showPhysicsQueries);
 